@@ -10,17 +10,33 @@
 #include <graphics/graphics.h>
 #include <application/window.h>
 
+namespace GE
+{
+    class TaskSchedulerModule;
+    class TaskGraph;
+    class FrameMemory;
+}
+
 namespace ge
 {
     class GalaxyEngine
     {
     public:
+        ~GalaxyEngine();
+
         void init();
         void run() const;
+
+        [[nodiscard]] GE::TaskSchedulerModule* get_scheduler() const;
+        [[nodiscard]] GE::TaskGraph* get_frame_graph() const;
+        [[nodiscard]] GE::FrameMemory* get_frame_memory() const;
     private:
         Logger *logger_ = nullptr;
         Window *window_ = nullptr;
         Graphics *graphics_ = nullptr;
+        GE::TaskSchedulerModule *scheduler_ = nullptr;
+        GE::TaskGraph *frame_graph_ = nullptr;
+        GE::FrameMemory *frame_memory_ = nullptr;
     };
 }
 
@@ -1,7 +1,29 @@
 #ifndef LOGGER_H
 #define LOGGER_H
+#include <application/timestamp.h>
+
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// 编译期最低日志级别，低于它的 GE_LOG_* 调用不生成代码。发布构建默认为 INFO
+#ifndef GE_LOG_MIN_LEVEL
+    #ifdef NDEBUG
+        #define GE_LOG_MIN_LEVEL 1
+    #else
+        #define GE_LOG_MIN_LEVEL 0
+    #endif
+#endif
 
 namespace ge
 {
@@ -12,21 +34,187 @@ namespace ge
         WARNING,
         ERROR,
         CRITICAL,
+        OFF,  // 只用作过滤级别，关闭全部日志
+    };
+
+    // 结构化字段，以 key=value 追加在消息后；字符串值加引号
+    template<typename T>
+    struct LogField
+    {
+        std::string_view key_;
+        const T& value_;
+    };
+
+    template<typename T>
+    LogField<T> field(const std::string_view key_, const T& value_)
+    {
+        return { key_, value_ };
+    }
+
+    // 在栈上拼接带字段的日志行，超出容量的部分截断
+    class LogLine
+    {
+    public:
+        static constexpr std::size_t capacity_ = 1024;
+
+        void append(const std::string_view text_)
+        {
+            const std::size_t length_ = text_.size() < capacity_ - size_ ? text_.size() : capacity_ - size_;
+            std::memcpy(buffer_ + size_, text_.data(), length_);
+            size_ += length_;
+        }
+
+        template<typename T>
+        void append_field(const LogField<T>& field_)
+        {
+            append(" ");
+            append(field_.key_);
+            append("=");
+            append_value(field_.value_);
+        }
+
+        [[nodiscard]] std::string_view view() const { return { buffer_, size_ }; }
+
+    private:
+        char buffer_[capacity_];
+        std::size_t size_ = 0;
 
+        template<typename T>
+        void append_value(const T& value_)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                append(value_ ? "true" : "false");
+            }
+            else if constexpr (std::is_enum_v<T>)
+            {
+                append_value(static_cast<std::underlying_type_t<T>>(value_));
+            }
+            else if constexpr (std::is_arithmetic_v<T>)
+            {
+                const auto result_ = std::to_chars(buffer_ + size_, buffer_ + capacity_, value_);
+                if (result_.ec == std::errc()) size_ = static_cast<std::size_t>(result_.ptr - buffer_);
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                append("\"");
+                append(std::string_view(value_));
+                append("\"");
+            }
+            else if constexpr (std::is_pointer_v<T>)
+            {
+                append("0x");
+                const auto result_ = std::to_chars(buffer_ + size_, buffer_ + capacity_,
+                                                   reinterpret_cast<std::uintptr_t>(value_), 16);
+                if (result_.ec == std::errc()) size_ = static_cast<std::size_t>(result_.ptr - buffer_);
+            }
+            else
+            {
+                static_assert(!sizeof(T), "unsupported log field type");
+            }
+        }
     };
 
+    // 日志环形缓冲区写满时的处理方式
+    enum class LogOverflowPolicy
+    {
+        Drop,   // 丢弃新消息并计数，调用线程从不等待
+        Block,  // 等待后台线程腾出空间
+    };
+
+    // 异步日志
+    // 调用线程只把原始时间戳计数、级别和消息字节写入本线程的无锁单生产者环形缓冲区；
+    // 后台线程按时间戳合并各线程的记录，格式化后成批写入文件。
     class Logger
     {
     public:
-        explicit Logger(const std::string& log_file_path_);
+        explicit Logger(const std::string& log_file_path_,
+                        LogOverflowPolicy overflow_policy_ = LogOverflowPolicy::Drop,
+                        std::size_t ring_capacity_ = 64 * 1024);
         ~Logger();
 
-        void log(LogLevel log_level_, const std::string& message_);
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        void log(LogLevel log_level_, std::string_view message_);
+
+        // 带结构化字段的日志，字段直接序列化进栈上缓冲区，不构造 std::string
+        template<typename T, typename... Ts>
+        void log(const LogLevel log_level_, const std::string_view message_, const LogField<T>& field_, const LogField<Ts>&... fields_)
+        {
+            if (!is_enabled(log_level_)) return;
+            LogLine line_;
+            line_.append(message_);
+            line_.append_field(field_);
+            (line_.append_field(fields_), ...);
+            log(log_level_, line_.view());
+        }
+
+        // 运行时最低级别，默认 DEBUG
+        void set_level(const LogLevel log_level_) { level_.store(log_level_, std::memory_order_relaxed); }
+        [[nodiscard]] LogLevel get_level() const { return level_.load(std::memory_order_relaxed); }
+        [[nodiscard]] bool is_enabled(const LogLevel log_level_) const
+        {
+            return log_level_ >= level_.load(std::memory_order_relaxed);
+        }
+
+        // 解析 debug.log_level 的取值：none, critical, error, warning, info, debug，无法识别时返回 INFO
+        static LogLevel parse_level(std::string_view name_);
+
+        // 等待此前写入的记录全部落盘
+        void flush();
+
+        [[nodiscard]] std::uint64_t get_dropped_count() const;
+
+        class Ring;
     private:
+        struct Record;
+
         std::ofstream output_file_;
+        LogOverflowPolicy overflow_policy_;
+        std::size_t ring_capacity_;
+        std::uint64_t logger_id_;
+
+        std::vector<std::shared_ptr<Ring>> rings_;
+        std::mutex rings_mutex_;
+
+        std::thread writer_thread_;
+        std::mutex writer_mutex_;
+        std::condition_variable writer_cv_;
+        std::condition_variable flushed_cv_;
+        std::uint64_t flush_requests_ = 0;
+        std::uint64_t flushes_done_ = 0;
+        bool stopping_ = false;
+        std::atomic<std::uint64_t> dropped_count_{0};
+        std::atomic<LogLevel> level_{DEBUG};
+
+        // 只由后台线程使用
+        TimestampFormatter timestamp_formatter_;
+
+        Ring& get_thread_ring();
+        void wake_writer();
+        void writer_thread_func();
+        bool drain(std::vector<Record>& records_, std::string& batch_);
 
         static std::string to_string(LogLevel log_level_) ;
     };
 }
 
+// 日志宏：低于 GE_LOG_MIN_LEVEL 的调用在编译期丢弃，低于运行时级别时不求值消息和字段参数
+// 用法：GE_LOG_INFO(logger, "Asset loaded", ge::field("path", path), ge::field("bytes", size));
+#define GE_LOG(logger_, log_level_, ...)                                                        \
+    do                                                                                          \
+    {                                                                                           \
+        if constexpr (static_cast<int>(log_level_) >= GE_LOG_MIN_LEVEL)                         \
+        {                                                                                       \
+            if ((logger_)->is_enabled(log_level_)) (logger_)->log(log_level_, __VA_ARGS__);     \
+        }                                                                                       \
+    } while (false)
+
+#define GE_LOG_DEBUG(logger_, ...)    GE_LOG(logger_, ::ge::DEBUG, __VA_ARGS__)
+#define GE_LOG_INFO(logger_, ...)     GE_LOG(logger_, ::ge::INFO, __VA_ARGS__)
+#define GE_LOG_WARNING(logger_, ...)  GE_LOG(logger_, ::ge::WARNING, __VA_ARGS__)
+#define GE_LOG_ERROR(logger_, ...)    GE_LOG(logger_, ::ge::ERROR, __VA_ARGS__)
+#define GE_LOG_CRITICAL(logger_, ...) GE_LOG(logger_, ::ge::CRITICAL, __VA_ARGS__)
+
 #endif
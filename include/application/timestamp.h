@@ -0,0 +1,77 @@
+#ifndef TIMESTAMP_H
+#define TIMESTAMP_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define GE_HAS_TSC 1
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#endif
+
+namespace ge
+{
+    // 时间戳时钟
+    // 记录点只读取原始计数：CPU 提供恒定频率的 TSC 时读取 TSC，否则读取 steady_clock 纳秒，
+    // 换算和格式化推迟到消费方（日志后台线程、分析器导出）进行。
+    class Timestamp
+    {
+    public:
+        static std::uint64_t now() noexcept
+        {
+#ifdef GE_HAS_TSC
+            if (tsc_enabled()) return __rdtsc();
+#endif
+            return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        }
+
+        // 启动时的粗略校准值，精确换算使用 TimestampFormatter
+        static double get_ticks_per_second();
+
+        static bool tsc_enabled() noexcept
+        {
+            static const bool enabled_ = detect_invariant_tsc();
+            return enabled_;
+        }
+
+    private:
+        static bool detect_invariant_tsc() noexcept;
+    };
+
+    // 把原始计数换算为本地时间并格式化为 "%Y-%m-%d %H:%M:%S.微秒"
+    // 同一秒内复用已格式化的日期前缀；每经过约一秒的计数以更长的基线重新校准频率并对齐系统时钟。
+    // 非线程安全，每个消费线程持有一个。
+    class TimestampFormatter
+    {
+    public:
+        static constexpr std::size_t max_length_ = 32;
+
+        TimestampFormatter();
+
+        // 自 1970 年起的系统时间纳秒
+        std::int64_t to_system_ns(std::uint64_t ticks_);
+
+        // 写入 out_，不追加结尾的 '\0'，返回写入的长度；out_ 至少 max_length_ 字节
+        std::size_t format(std::uint64_t ticks_, char* out_);
+
+    private:
+        std::uint64_t base_ticks_;
+        std::int64_t base_steady_ns_;
+        std::uint64_t anchor_ticks_ = 0;
+        std::int64_t anchor_system_ns_ = 0;
+        double ticks_per_ns_ = 1.0;
+
+        std::int64_t cached_second_ = -1;
+        char cached_prefix_[max_length_] = {};
+        std::size_t cached_prefix_length_ = 0;
+
+        void calibrate();
+    };
+}
+
+#endif
@@ -4,22 +4,112 @@
 
 #include <application/galaxy_engine.h>
 
+#include <core/TaskScheduler.h>
+#include <core/TaskGraph.h>
+#include <core/FrameArena.h>
+#include <core/MemoryManager.h>
+#include <core/Profiler.h>
+#include <core/Settings.h>
+
+ge::GalaxyEngine::~GalaxyEngine()
+{
+#ifdef GE_ENABLE_PROFILER
+    // 导出前停止记录，任务图节点名已驻留在分析器中，可以先释放任务图
+    if (GE::Profiler::Get().IsRecording())
+    {
+        GE::Profiler::Get().Stop();
+        const std::string output_path = GE::Settings::Get().GetString("debug.profiler_output", "logs/profile.json");
+        if (GE::Profiler::Get().ExportChromeTrace(output_path))
+        {
+            GE_LOG_INFO(logger_, "Profile exported", field("path", output_path),
+                        field("dropped_events", GE::Profiler::Get().GetDroppedEventCount()));
+        }
+    }
+#endif
+    GE::MemoryManagerModule::GetDefault().SetBudgetCallback(nullptr);
+    delete frame_graph_;
+    if (scheduler_) scheduler_->shutdown();
+    delete frame_memory_;
+    delete scheduler_;
+    delete window_;
+    delete logger_;
+}
+
 void ge::GalaxyEngine::init()
 {
-    logger_ = new Logger("logs");
-    logger_->log(INFO, "Initializing Galaxy engine...");
+    // 日志由后台线程写出，debug.log_overflow 决定缓冲区写满时丢弃还是等待
+    const GE::Settings& settings = GE::Settings::Get();
+    logger_ = new Logger("logs",
+        settings.GetString("debug.log_overflow", "drop") == "block" ? LogOverflowPolicy::Block : LogOverflowPolicy::Drop,
+        static_cast<std::size_t>(settings.GetInt("debug.log_ring_kb", 64)) * 1024);
+    logger_->set_level(Logger::parse_level(settings.GetString("debug.log_level", "info")));
+    GE_LOG_INFO(logger_, "Initializing Galaxy engine...");
+
+#ifdef GE_ENABLE_PROFILER
+    // 分析器在调度器之前配置，工作线程注册时按此分配事件缓冲区
+    GE::Profiler::Get().SetMaxEventsPerThread(static_cast<std::size_t>(settings.GetInt("debug.profiler_max_events", 1048576)));
+    GE_PROFILE_THREAD("GE Main");
+    if (settings.GetBool("debug.profiler_capture", false)) GE::Profiler::Get().Start();
+#endif
 
     window_ = new Window();
     window_->create_window(1920, 1080, "Galaxy Engine");
+
+    scheduler_ = new GE::TaskSchedulerModule();
+    scheduler_->initialize();
+    scheduler_->SetFrameBudget(std::chrono::microseconds(settings.GetInt("performance.frame_budget_us", 16667)),
+                               std::chrono::microseconds(settings.GetInt("performance.background_budget_us", 4000)));
+
+    // 内存总量超过 performance.memory_warning_threshold 时记录警告
+    GE::MemoryManagerModule::GetDefault().SetBudgetCallback([this](const GE::MemoryStats& stats, std::int64_t threshold)
+    {
+        GE_LOG_WARNING(logger_, "Memory usage exceeds warning threshold",
+                       field("usage_mb", stats.totalBytes / (1024 * 1024)),
+                       field("threshold_mb", threshold / (1024 * 1024)));
+    });
+
+    // 帧内生命周期的数据（命令列表、剔除结果、临时字符串等）从帧内存分配，每帧整体回收
+    frame_memory_ = new GE::FrameMemory(
+        static_cast<std::size_t>(settings.GetInt("performance.frame_buffer_count", 2)),
+        static_cast<std::size_t>(settings.GetInt("performance.frame_arena_kb", 1024)) * 1024);
+
+    // 各子系统向帧任务图注册阶段及其依赖，run 中每帧执行一次
+    frame_graph_ = new GE::TaskGraph();
 }
 
 void ge::GalaxyEngine::run() const
 {
-    logger_->log(INFO, "Running Galaxy engine...");
+    GE_LOG_INFO(logger_, "Running Galaxy engine...");
 
     while (!glfwWindowShouldClose(window_->get_window()))
     {
-        glfwPollEvents();
+        GE_PROFILE_FRAME();
+        {
+            GE_PROFILE_ZONE("Poll Events");
+            glfwPollEvents();
+        }
+        frame_memory_->BeginFrame();
+        scheduler_->BeginFrame();
+        {
+            GE_PROFILE_ZONE("Frame Graph");
+            frame_graph_->Run(*scheduler_);
+        }
+        GE::MemoryManagerModule::GetDefault().update();
     }
 }
 
+GE::TaskSchedulerModule *ge::GalaxyEngine::get_scheduler() const
+{
+    return scheduler_;
+}
+
+GE::TaskGraph *ge::GalaxyEngine::get_frame_graph() const
+{
+    return frame_graph_;
+}
+
+GE::FrameMemory *ge::GalaxyEngine::get_frame_memory() const
+{
+    return frame_memory_;
+}
+
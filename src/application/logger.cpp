@@ -1,23 +1,341 @@
 #include <application/logger.h>
 #include <application/utils.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
+#include <utility>
 
-ge::Logger::Logger(const std::string& log_file_path_)
+namespace
+{
+    // 记录头，记录按 16 字节对齐，回绕处的剩余空间总能放下一个填充记录头
+    struct RecordHeader
+    {
+        std::uint64_t timestamp_;
+        std::uint32_t length_;
+        std::uint8_t level_;
+        std::uint8_t padding_;
+        std::uint16_t reserved_;
+    };
+    static_assert(sizeof(RecordHeader) == 16);
+
+    constexpr std::size_t record_alignment_ = 16;
+    constexpr std::size_t min_ring_capacity_ = 4 * 1024;
+    constexpr auto writer_interval_ = std::chrono::milliseconds(5);
+
+    std::atomic<std::uint64_t> next_logger_id_{1};
+
+    std::size_t round_up_capacity(const std::size_t capacity_)
+    {
+        std::size_t rounded_ = min_ring_capacity_;
+        while (rounded_ < capacity_) rounded_ <<= 1;
+        return rounded_;
+    }
+
+    std::size_t record_size(const std::size_t length_)
+    {
+        return (sizeof(RecordHeader) + length_ + record_alignment_ - 1) & ~(record_alignment_ - 1);
+    }
+
+}
+
+// 单生产者单消费者字节环形缓冲区，生产者为拥有它的线程，消费者为后台写入线程
+class ge::Logger::Ring
+{
+public:
+    explicit Ring(const std::size_t capacity_)
+        : capacity_(capacity_), mask_(capacity_ - 1), buffer_(new char[capacity_])
+    {
+    }
+
+    // 返回 false 表示空间不足
+    bool try_write(const LogLevel log_level_, const std::uint64_t timestamp_, const std::string_view message_)
+    {
+        const std::size_t size_ = record_size(message_.size());
+        const std::uint64_t head_ = head_position_.load(std::memory_order_relaxed);
+        const std::size_t offset_ = head_ & mask_;
+        const std::size_t contiguous_ = capacity_ - offset_;
+        const std::size_t wrap_ = contiguous_ < size_ ? contiguous_ : 0;
+
+        if (head_ + wrap_ + size_ - cached_tail_ > capacity_)
+        {
+            cached_tail_ = tail_position_.load(std::memory_order_acquire);
+            if (head_ + wrap_ + size_ - cached_tail_ > capacity_) return false;
+        }
+
+        std::uint64_t position_ = head_;
+        if (wrap_ != 0)
+        {
+            RecordHeader padding_header_{};
+            padding_header_.padding_ = 1;
+            std::memcpy(buffer_.get() + offset_, &padding_header_, sizeof(padding_header_));
+            position_ += wrap_;
+        }
+
+        char* record_ = buffer_.get() + (position_ & mask_);
+        const RecordHeader header_{ timestamp_, static_cast<std::uint32_t>(message_.size()),
+                                    static_cast<std::uint8_t>(log_level_), 0, 0 };
+        std::memcpy(record_, &header_, sizeof(header_));
+        std::memcpy(record_ + sizeof(header_), message_.data(), message_.size());
+        head_position_.store(position_ + size_, std::memory_order_release);
+        return true;
+    }
+
+    // 先用缓存的 tail 判断，超过一半时才读取后台线程的最新进度
+    bool is_over_half()
+    {
+        const std::uint64_t head_ = head_position_.load(std::memory_order_relaxed);
+        if (head_ - cached_tail_ <= capacity_ / 2) return false;
+        cached_tail_ = tail_position_.load(std::memory_order_acquire);
+        return head_ - cached_tail_ > capacity_ / 2;
+    }
+
+    // 以下由后台线程调用：先按 head 快照读取，再释放到快照位置
+    [[nodiscard]] std::uint64_t get_head() const { return head_position_.load(std::memory_order_acquire); }
+    [[nodiscard]] std::uint64_t get_tail() const { return tail_position_.load(std::memory_order_relaxed); }
+    void release(const std::uint64_t position_) { tail_position_.store(position_, std::memory_order_release); }
+
+    [[nodiscard]] const char* at(const std::uint64_t position_) const { return buffer_.get() + (position_ & mask_); }
+
+    // 到缓冲区末尾的剩余字节数，用于跳过填充记录
+    [[nodiscard]] std::size_t get_contiguous(const std::uint64_t position_) const { return capacity_ - (position_ & mask_); }
+
+    std::atomic<bool> in_use_{true};
+
+private:
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::unique_ptr<char[]> buffer_;
+
+    alignas(64) std::atomic<std::uint64_t> head_position_{0};
+    std::uint64_t cached_tail_ = 0;
+    alignas(64) std::atomic<std::uint64_t> tail_position_{0};
+};
+
+struct ge::Logger::Record
+{
+    std::uint64_t timestamp_;
+    LogLevel level_;
+    std::string_view message_;
+};
+
+namespace
+{
+    // 线程退出时把本线程的缓冲区交还给日志器复用，剩余记录仍由后台线程写出
+    struct ThreadRings
+    {
+        std::vector<std::pair<std::uint64_t, std::shared_ptr<ge::Logger::Ring>>> rings_;
+
+        ~ThreadRings()
+        {
+            for (auto& [logger_id_, ring_] : rings_) ring_->in_use_.store(false, std::memory_order_release);
+        }
+    };
+
+    thread_local ThreadRings thread_rings_;
+}
+
+ge::Logger::Logger(const std::string& log_file_path_, const LogOverflowPolicy overflow_policy_, const std::size_t ring_capacity_)
+    : overflow_policy_(overflow_policy_),
+      ring_capacity_(round_up_capacity(ring_capacity_)),
+      logger_id_(next_logger_id_.fetch_add(1, std::memory_order_relaxed))
 {
     if (!std::filesystem::exists(log_file_path_)) std::filesystem::create_directory(log_file_path_);
         output_file_ = std::ofstream(log_file_path_ + "/" + get_date_time() + ".log");
+
+    writer_thread_ = std::thread(&Logger::writer_thread_func, this);
 }
 
 ge::Logger::~Logger()
 {
+    {
+        std::lock_guard lock_(writer_mutex_);
+        stopping_ = true;
+    }
+    writer_cv_.notify_one();
+    writer_thread_.join();
     output_file_.close();
 }
 
-void ge::Logger::log(const LogLevel log_level_, const std::string& message_)
+void ge::Logger::log(const LogLevel log_level_, std::string_view message_)
+{
+    if (!is_enabled(log_level_)) return;
+
+    const std::uint64_t timestamp_ = Timestamp::now();
+    Ring& ring_ = get_thread_ring();
+
+    // 单条消息最多占半个缓冲区，超出部分截断
+    const std::size_t max_length_ = ring_capacity_ / 2 - sizeof(RecordHeader);
+    if (message_.size() > max_length_) message_ = message_.substr(0, max_length_);
+
+    while (!ring_.try_write(log_level_, timestamp_, message_))
+    {
+        if (overflow_policy_ == LogOverflowPolicy::Drop)
+        {
+            dropped_count_.fetch_add(1, std::memory_order_relaxed);
+            wake_writer();
+            return;
+        }
+        wake_writer();
+        std::this_thread::yield();
+    }
+
+    // 缓冲区过半时提前唤醒后台线程，避免突发日志在定时写出前写满
+    if (ring_.is_over_half()) wake_writer();
+}
+
+void ge::Logger::flush()
+{
+    std::unique_lock lock_(writer_mutex_);
+    const std::uint64_t request_ = ++flush_requests_;
+    writer_cv_.notify_one();
+    flushed_cv_.wait(lock_, [&] { return flushes_done_ >= request_; });
+}
+
+std::uint64_t ge::Logger::get_dropped_count() const
+{
+    return dropped_count_.load(std::memory_order_relaxed);
+}
+
+ge::Logger::Ring& ge::Logger::get_thread_ring()
+{
+    for (auto& [logger_id_, ring_] : thread_rings_.rings_)
+    {
+        if (logger_id_ == this->logger_id_) return *ring_;
+    }
+
+    std::shared_ptr<Ring> ring_;
+    {
+        std::lock_guard lock_(rings_mutex_);
+        // 优先复用已退出线程留下的缓冲区
+        for (const auto& candidate_ : rings_)
+        {
+            bool expected_ = false;
+            if (candidate_->in_use_.compare_exchange_strong(expected_, true, std::memory_order_acquire))
+            {
+                ring_ = candidate_;
+                break;
+            }
+        }
+        if (!ring_)
+        {
+            ring_ = std::make_shared<Ring>(ring_capacity_);
+            rings_.push_back(ring_);
+        }
+    }
+    thread_rings_.rings_.emplace_back(logger_id_, ring_);
+    return *ring_;
+}
+
+void ge::Logger::wake_writer()
+{
+    // 后台线程本身定时醒来，这里不加锁，丢失的唤醒最多推迟一个周期
+    writer_cv_.notify_one();
+}
+
+void ge::Logger::writer_thread_func()
+{
+    std::vector<Record> records_;
+    std::string batch_;
+    std::uint64_t reported_dropped_ = 0;
+
+    while (true)
+    {
+        std::uint64_t flush_request_;
+        bool stopping_now_;
+        {
+            std::unique_lock lock_(writer_mutex_);
+            writer_cv_.wait_for(lock_, writer_interval_, [&] { return stopping_ || flush_requests_ != flushes_done_; });
+            flush_request_ = flush_requests_;
+            stopping_now_ = stopping_;
+        }
+
+        bool written_ = false;
+        while (drain(records_, batch_))
+        {
+            output_file_.write(batch_.data(), static_cast<std::streamsize>(batch_.size()));
+            written_ = true;
+        }
+
+        const std::uint64_t dropped_ = dropped_count_.load(std::memory_order_relaxed);
+        if (dropped_ != reported_dropped_)
+        {
+            char date_time_[TimestampFormatter::max_length_];
+            const std::size_t date_time_length_ = timestamp_formatter_.format(Timestamp::now(), date_time_);
+            output_file_ << "[" << std::string_view(date_time_, date_time_length_) << "] [" << to_string(WARNING) << "] >> "
+                         << dropped_ - reported_dropped_ << " log messages dropped (ring buffer full)\n";
+            reported_dropped_ = dropped_;
+            written_ = true;
+        }
+
+        if (written_) output_file_.flush();
+
+        {
+            std::lock_guard lock_(writer_mutex_);
+            if (flushes_done_ < flush_request_) flushes_done_ = flush_request_;
+        }
+        flushed_cv_.notify_all();
+
+        if (stopping_now_) break;
+    }
+}
+
+bool ge::Logger::drain(std::vector<Record>& records_, std::string& batch_)
+{
+    std::vector<std::pair<std::shared_ptr<Ring>, std::uint64_t>> snapshots_;
+    {
+        std::lock_guard lock_(rings_mutex_);
+        snapshots_.reserve(rings_.size());
+        for (const auto& ring_ : rings_) snapshots_.emplace_back(ring_, 0);
+    }
+
+    records_.clear();
+    for (auto& [ring_, head_] : snapshots_)
+    {
+        head_ = ring_->get_head();
+        for (std::uint64_t position_ = ring_->get_tail(); position_ < head_;)
+        {
+            RecordHeader header_;
+            std::memcpy(&header_, ring_->at(position_), sizeof(header_));
+            if (header_.padding_)
+            {
+                position_ += ring_->get_contiguous(position_);
+                continue;
+            }
+            records_.push_back({ header_.timestamp_, static_cast<LogLevel>(header_.level_),
+                                 std::string_view(ring_->at(position_) + sizeof(header_), header_.length_) });
+            position_ += record_size(header_.length_);
+        }
+    }
+    if (records_.empty()) return false;
+
+    // 各线程的记录各自有序，合并后按时间戳输出
+    std::stable_sort(records_.begin(), records_.end(),
+                     [](const Record& a_, const Record& b_) { return a_.timestamp_ < b_.timestamp_; });
+
+    batch_.clear();
+    char date_time_[TimestampFormatter::max_length_];
+    for (const Record& record_ : records_)
+    {
+        const std::size_t date_time_length_ = timestamp_formatter_.format(record_.timestamp_, date_time_);
+        batch_.append("[").append(date_time_, date_time_length_).append("] [")
+              .append(to_string(record_.level_)).append("] >> ").append(record_.message_).append("\n");
+    }
+
+    for (auto& [ring_, head_] : snapshots_) ring_->release(head_);
+    return true;
+}
+
+ge::LogLevel ge::Logger::parse_level(const std::string_view name_)
 {
-    const std::string log_message_ = "[" + get_date_time() + "] " + "[" + to_string(log_level_) + "]" + " >> " + message_;
-    output_file_ << log_message_ << std::endl;
+    if (name_ == "none")     return OFF;
+    if (name_ == "critical") return CRITICAL;
+    if (name_ == "error")    return ERROR;
+    if (name_ == "warning")  return WARNING;
+    if (name_ == "info")     return INFO;
+    if (name_ == "debug")    return DEBUG;
+    return INFO;
 }
 
 std::string ge::Logger::to_string (const LogLevel log_level_)
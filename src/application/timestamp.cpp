@@ -0,0 +1,131 @@
+#include <application/timestamp.h>
+
+#include <ctime>
+
+#ifdef GE_HAS_TSC
+    #ifndef _MSC_VER
+        #include <cpuid.h>
+    #endif
+#endif
+
+namespace
+{
+    std::int64_t steady_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::int64_t system_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+}
+
+bool ge::Timestamp::detect_invariant_tsc() noexcept
+{
+#ifdef GE_HAS_TSC
+    // CPUID 0x80000007 EDX 第 8 位：TSC 频率不随变频和睡眠状态变化
+    unsigned int registers_[4] = {};
+#ifdef _MSC_VER
+    int values_[4];
+    __cpuid(values_, 0x80000000);
+    if (static_cast<unsigned int>(values_[0]) < 0x80000007) return false;
+    __cpuid(values_, 0x80000007);
+    registers_[3] = static_cast<unsigned int>(values_[3]);
+#else
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007) return false;
+    __get_cpuid(0x80000007, &registers_[0], &registers_[1], &registers_[2], &registers_[3]);
+#endif
+    return (registers_[3] & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+double ge::Timestamp::get_ticks_per_second()
+{
+    static const double ticks_per_second_ = []
+    {
+        if (!tsc_enabled()) return 1e9;
+
+        // 以 steady_clock 为基准测量 2 毫秒内的 TSC 计数
+        const std::int64_t start_ns_ = steady_ns();
+        const std::uint64_t start_ticks_ = now();
+        std::int64_t end_ns_;
+        do
+        {
+            end_ns_ = steady_ns();
+        } while (end_ns_ - start_ns_ < 2000000);
+        const std::uint64_t end_ticks_ = now();
+        return static_cast<double>(end_ticks_ - start_ticks_) * 1e9 / static_cast<double>(end_ns_ - start_ns_);
+    }();
+    return ticks_per_second_;
+}
+
+ge::TimestampFormatter::TimestampFormatter()
+    : base_ticks_(Timestamp::now()), base_steady_ns_(steady_ns())
+{
+    ticks_per_ns_ = Timestamp::get_ticks_per_second() / 1e9;
+    anchor_ticks_ = base_ticks_;
+    anchor_system_ns_ = system_ns();
+}
+
+void ge::TimestampFormatter::calibrate()
+{
+    const std::uint64_t ticks_ = Timestamp::now();
+    const std::int64_t steady_ = steady_ns();
+    if (Timestamp::tsc_enabled() && steady_ > base_steady_ns_)
+    {
+        ticks_per_ns_ = static_cast<double>(ticks_ - base_ticks_) / static_cast<double>(steady_ - base_steady_ns_);
+    }
+    // 重新对齐系统时钟，系统时间被调整后随之生效
+    anchor_ticks_ = ticks_;
+    anchor_system_ns_ = system_ns();
+}
+
+std::int64_t ge::TimestampFormatter::to_system_ns(const std::uint64_t ticks_)
+{
+    if (ticks_ > anchor_ticks_ && static_cast<double>(ticks_ - anchor_ticks_) > ticks_per_ns_ * 1e9) calibrate();
+
+    const double delta_ = ticks_ >= anchor_ticks_
+        ? static_cast<double>(ticks_ - anchor_ticks_)
+        : -static_cast<double>(anchor_ticks_ - ticks_);
+    return anchor_system_ns_ + static_cast<std::int64_t>(delta_ / ticks_per_ns_);
+}
+
+std::size_t ge::TimestampFormatter::format(const std::uint64_t ticks_, char* out_)
+{
+    const std::int64_t ns_ = to_system_ns(ticks_);
+    std::int64_t second_ = ns_ / 1000000000;
+    std::int64_t micro_ = ns_ % 1000000000 / 1000;
+    if (micro_ < 0)
+    {
+        second_ -= 1;
+        micro_ += 1000000;
+    }
+
+    if (second_ != cached_second_)
+    {
+        const std::time_t time_ = static_cast<std::time_t>(second_);
+        std::tm local_time_{};
+#ifdef _WIN32
+        localtime_s(&local_time_, &time_);
+#else
+        localtime_r(&time_, &local_time_);
+#endif
+        cached_prefix_length_ = std::strftime(cached_prefix_, sizeof(cached_prefix_), "%Y-%m-%d %H:%M:%S", &local_time_);
+        cached_second_ = second_;
+    }
+
+    char* end_ = out_;
+    for (std::size_t i_ = 0; i_ < cached_prefix_length_; ++i_) *end_++ = cached_prefix_[i_];
+    *end_++ = '.';
+    for (int digit_ = 5; digit_ >= 0; --digit_)
+    {
+        end_[digit_] = static_cast<char>('0' + micro_ % 10);
+        micro_ /= 10;
+    }
+    return static_cast<std::size_t>(end_ + 6 - out_);
+}
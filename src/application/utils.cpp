@@ -3,18 +3,23 @@
 //
 #include <application/utils.h>
 
-#include <filesystem>
-#include <iomanip>
+#include <chrono>
 #include <ctime>
 
 std::string get_date_time()
 {
     const auto now_time_ = std::chrono::system_clock::now();
     const std::time_t current_time_ = std::chrono::system_clock::to_time_t(now_time_);
-    const std::tm local_time_ = *std::localtime(&current_time_);
 
-    std::ostringstream oss_;
-    oss_ << std::put_time(&local_time_, "%Y-%m-%d %H:%M:%S");
-    std::string date_time_ = oss_.str();
-    return date_time_;
-}
\ No newline at end of file
+    // std::localtime 返回共享的静态缓冲区，多线程下使用可重入版本
+    std::tm local_time_{};
+#ifdef _WIN32
+    localtime_s(&local_time_, &current_time_);
+#else
+    localtime_r(&current_time_, &local_time_);
+#endif
+
+    char date_time_[32];
+    const std::size_t length_ = std::strftime(date_time_, sizeof(date_time_), "%Y-%m-%d %H:%M:%S", &local_time_);
+    return { date_time_, length_ };
+}
@@ -0,0 +1,283 @@
+#include "AssetArchive.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_set>
+
+#ifdef GE_HAS_ZLIB
+    #include <zlib.h>
+#endif
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace GE {
+
+namespace {
+    // zlib 的最大压缩比约为 1032:1，解压后大小超过它的条目必然损坏
+    constexpr std::uint64_t kMaxCompressionRatio = 1032;
+
+    std::uint64_t AlignUp(std::uint64_t value, std::uint64_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    bool ReadFile(const std::string& filePath, std::vector<char>& data) {
+        std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        data.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        return data.empty() || static_cast<bool>(file.read(data.data(), static_cast<std::streamsize>(data.size())));
+    }
+
+    void WritePadding(std::ofstream& output, std::uint64_t& position, std::uint64_t alignment) {
+        static const char zeros[4096] = {};
+        std::uint64_t aligned = AlignUp(position, alignment);
+        while (position < aligned) {
+            std::uint64_t count = std::min<std::uint64_t>(aligned - position, sizeof(zeros));
+            output.write(zeros, static_cast<std::streamsize>(count));
+            position += count;
+        }
+    }
+}
+
+std::shared_ptr<AssetArchive> AssetArchive::Open(const std::string& archivePath) {
+    // 条目按打包顺序排列，顺序加载时保留内核默认预读
+    std::shared_ptr<MappedFile> file = MappedFile::Open(archivePath, AccessPattern::Normal);
+    if (!file) {
+        return nullptr;
+    }
+
+    const char* data = file->GetData();
+    std::size_t size = file->GetSize();
+    if (size < sizeof(AssetArchiveHeader)) {
+        std::cerr << "资源包文件过小: " << archivePath << std::endl;
+        return nullptr;
+    }
+    const AssetArchiveHeader* header = reinterpret_cast<const AssetArchiveHeader*>(data);
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion) {
+        std::cerr << "不支持的资源包格式: " << archivePath << std::endl;
+        return nullptr;
+    }
+    std::uint64_t indexSize = static_cast<std::uint64_t>(header->entryCount) * sizeof(AssetArchiveEntry);
+    if (header->indexOffset % alignof(AssetArchiveEntry) != 0 || header->indexOffset > size || indexSize > size - header->indexOffset ||
+        header->namesOffset > size || header->namesSize > size - header->namesOffset) {
+        std::cerr << "资源包索引损坏: " << archivePath << std::endl;
+        return nullptr;
+    }
+
+    std::shared_ptr<AssetArchive> archive(new AssetArchive());
+    archive->archivePath = archivePath;
+    archive->header = header;
+    archive->entries = reinterpret_cast<const AssetArchiveEntry*>(data + header->indexOffset);
+    archive->names = data + header->namesOffset;
+
+    for (std::uint32_t i = 0; i < header->entryCount; ++i) {
+        const AssetArchiveEntry& entry = archive->entries[i];
+        if (entry.offset > size || entry.storedSize > size - entry.offset ||
+            static_cast<std::uint64_t>(entry.nameOffset) + entry.nameLength > header->namesSize) {
+            std::cerr << "资源包条目越界: " << archivePath << std::endl;
+            return nullptr;
+        }
+        // 解压缓冲按 size 分配，不可信的 size 会导致超大分配
+        bool compressed = (entry.flags & AssetArchiveEntry::kCompressed) != 0;
+        if (compressed ? entry.size / kMaxCompressionRatio > entry.storedSize : entry.size != entry.storedSize) {
+            std::cerr << "资源包条目大小无效: " << archivePath << std::endl;
+            return nullptr;
+        }
+    }
+
+    archive->file = std::move(file);
+#ifndef _WIN32
+    archive->readHandle = open(archivePath.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+    return archive;
+}
+
+AssetArchive::~AssetArchive() {
+#ifndef _WIN32
+    if (readHandle >= 0) {
+        close(readHandle);
+    }
+#endif
+}
+
+std::string AssetArchive::NormalizePath(const std::string& path) {
+    std::string normalized = path;
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+    while (normalized.compare(0, 2, "./") == 0) {
+        normalized.erase(0, 2);
+    }
+    return normalized;
+}
+
+std::uint64_t AssetArchive::HashPath(const std::string& normalizedPath) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : normalizedPath) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+const AssetArchiveEntry* AssetArchive::Find(const std::string& path) const {
+    std::string normalized = NormalizePath(path);
+    std::uint64_t hash = HashPath(normalized);
+    const AssetArchiveEntry* end = entries + header->entryCount;
+    const AssetArchiveEntry* it = std::lower_bound(entries, end, hash, [](const AssetArchiveEntry& entry, std::uint64_t value) {
+        return entry.pathHash < value;
+    });
+    for (; it != end && it->pathHash == hash; ++it) {
+        if (it->nameLength == normalized.size() && std::memcmp(names + it->nameOffset, normalized.data(), normalized.size()) == 0) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+ResourceView AssetArchive::GetView(const AssetArchiveEntry& entry, AccessPattern pattern) const {
+    if (entry.flags & AssetArchiveEntry::kCompressed) {
+        std::shared_ptr<std::vector<char>> data = Read(entry);
+        if (!data) {
+            return ResourceView();
+        }
+        return ResourceView(data->data(), data->size(), data);
+    }
+    file->Advise(pattern, static_cast<std::size_t>(entry.offset), static_cast<std::size_t>(entry.storedSize));
+    return ResourceView(file->GetData() + entry.offset, static_cast<std::size_t>(entry.size), file);
+}
+
+std::shared_ptr<std::vector<char>> AssetArchive::Read(const AssetArchiveEntry& entry) const {
+    // 复制前让内核一次读入整个区间，避免逐页缺页
+    file->Advise(AccessPattern::WillNeed, static_cast<std::size_t>(entry.offset), static_cast<std::size_t>(entry.storedSize));
+    const char* source = file->GetData() + entry.offset;
+    if (!(entry.flags & AssetArchiveEntry::kCompressed)) {
+        return std::make_shared<std::vector<char>>(source, source + entry.size);
+    }
+
+#ifdef GE_HAS_ZLIB
+    auto data = std::make_shared<std::vector<char>>(static_cast<std::size_t>(entry.size));
+    uLongf size = static_cast<uLongf>(entry.size);
+    int result = uncompress(reinterpret_cast<Bytef*>(data->data()), &size,
+                            reinterpret_cast<const Bytef*>(source), static_cast<uLong>(entry.storedSize));
+    if (result != Z_OK || size != entry.size) {
+        std::cerr << "解压资源失败: " << GetEntryPath(entry) << std::endl;
+        return nullptr;
+    }
+    return data;
+#else
+    std::cerr << "未启用 zlib，无法解压资源: " << GetEntryPath(entry) << std::endl;
+    return nullptr;
+#endif
+}
+
+std::string AssetArchive::GetEntryPath(const AssetArchiveEntry& entry) const {
+    return std::string(names + entry.nameOffset, entry.nameLength);
+}
+
+AssetArchiveWriter::AssetArchiveWriter(std::uint32_t alignment) : alignment(alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        throw std::runtime_error("资源包对齐必须是 2 的幂");
+    }
+}
+
+void AssetArchiveWriter::AddFile(const std::string& archivePath, const std::string& sourcePath, bool compress) {
+    files.push_back({ AssetArchive::NormalizePath(archivePath), sourcePath, compress });
+}
+
+bool AssetArchiveWriter::Write(const std::string& outputPath) {
+    std::unordered_set<std::string> seen;
+    for (const PendingFile& pending : files) {
+        if (!seen.insert(pending.archivePath).second) {
+            std::cerr << "资源包内路径重复: " << pending.archivePath << std::endl;
+            return false;
+        }
+    }
+
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        std::cerr << "无法创建资源包: " << outputPath << std::endl;
+        return false;
+    }
+
+    AssetArchiveHeader header{};
+    std::memcpy(header.magic, AssetArchive::kMagic, sizeof(header.magic));
+    header.version = AssetArchive::kVersion;
+    header.entryCount = static_cast<std::uint32_t>(files.size());
+    header.alignment = alignment;
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::uint64_t position = sizeof(header);
+
+    std::vector<AssetArchiveEntry> entries;
+    entries.reserve(files.size());
+    std::string names;
+    std::vector<char> data;
+    for (const PendingFile& pending : files) {
+        if (!ReadFile(pending.sourcePath, data)) {
+            std::cerr << "无法读取资源文件: " << pending.sourcePath << std::endl;
+            return false;
+        }
+
+        AssetArchiveEntry entry{};
+        entry.pathHash = AssetArchive::HashPath(pending.archivePath);
+        entry.size = data.size();
+        entry.nameOffset = static_cast<std::uint32_t>(names.size());
+        entry.nameLength = static_cast<std::uint32_t>(pending.archivePath.size());
+        names += pending.archivePath;
+
+        const char* stored = data.data();
+        entry.storedSize = data.size();
+#ifdef GE_HAS_ZLIB
+        std::vector<char> compressed;
+        if (pending.compress && !data.empty()) {
+            uLongf compressedSize = compressBound(static_cast<uLong>(data.size()));
+            compressed.resize(compressedSize);
+            if (compress2(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize,
+                          reinterpret_cast<const Bytef*>(data.data()), static_cast<uLong>(data.size()), Z_BEST_COMPRESSION) == Z_OK &&
+                compressedSize < data.size()) {
+                stored = compressed.data();
+                entry.storedSize = compressedSize;
+                entry.flags |= AssetArchiveEntry::kCompressed;
+            }
+        }
+#else
+        if (pending.compress) {
+            std::cerr << "未启用 zlib，按原样存储: " << pending.archivePath << std::endl;
+        }
+#endif
+
+        WritePadding(output, position, alignment);
+        entry.offset = position;
+        output.write(stored, static_cast<std::streamsize>(entry.storedSize));
+        position += entry.storedSize;
+        entries.push_back(entry);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const AssetArchiveEntry& a, const AssetArchiveEntry& b) {
+        return a.pathHash < b.pathHash;
+    });
+
+    WritePadding(output, position, alignof(AssetArchiveEntry));
+    header.indexOffset = position;
+    output.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(AssetArchiveEntry)));
+    position += entries.size() * sizeof(AssetArchiveEntry);
+    header.namesOffset = position;
+    header.namesSize = names.size();
+    output.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    // 索引位置确定后回写文件头
+    output.seekp(0);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!output) {
+        std::cerr << "写入资源包失败: " << outputPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace GE
@@ -0,0 +1,116 @@
+#ifndef ASSETARCHIVE_H
+#define ASSETARCHIVE_H
+
+#include "MappedFile.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GE {
+
+// 资源包文件布局（小端）：
+//   AssetArchiveHeader | 按 alignment 对齐的条目数据 | 按路径哈希排序的 AssetArchiveEntry 索引 | 路径字符串表
+// 索引放在末尾，打包时条目数据可以顺序写出；读取时整个包只映射一次，索引直接在映射上二分查找。
+struct AssetArchiveHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t alignment;
+    std::uint64_t indexOffset;
+    std::uint64_t namesOffset;
+    std::uint64_t namesSize;
+    std::uint64_t reserved;
+};
+static_assert(sizeof(AssetArchiveHeader) == 48, "资源包文件头大小必须固定");
+
+struct AssetArchiveEntry {
+    static constexpr std::uint32_t kCompressed = 1u << 0;  // 数据使用 zlib 压缩
+
+    std::uint64_t pathHash;
+    std::uint64_t offset;
+    std::uint64_t storedSize;  // 包内占用的字节数
+    std::uint64_t size;        // 解压后的字节数
+    std::uint32_t nameOffset;
+    std::uint32_t nameLength;
+    std::uint32_t flags;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(AssetArchiveEntry) == 48, "资源包索引项大小必须固定");
+
+// 只读资源包
+// 未压缩条目以映射切片的形式返回，不复制数据；压缩条目在读取时解压。
+class AssetArchive {
+public:
+    static constexpr char kMagic[4] = { 'G', 'E', 'P', 'K' };
+    static constexpr std::uint32_t kVersion = 1;
+
+    // 映射并校验资源包，失败时返回空
+    static std::shared_ptr<AssetArchive> Open(const std::string& archivePath);
+
+    ~AssetArchive();
+
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    // 包内路径统一使用 '/' 分隔并去掉开头的 "./"
+    static std::string NormalizePath(const std::string& path);
+
+    // 规范化路径的 64 位 FNV-1a 哈希
+    static std::uint64_t HashPath(const std::string& normalizedPath);
+
+    // 查找条目，不存在时返回空；哈希冲突时比较完整路径
+    const AssetArchiveEntry* Find(const std::string& path) const;
+
+    // 条目的只读视图，视图持有整个包的映射
+    ResourceView GetView(const AssetArchiveEntry& entry, AccessPattern pattern = AccessPattern::Sequential) const;
+
+    // 复制（或解压）条目数据
+    std::shared_ptr<std::vector<char>> Read(const AssetArchiveEntry& entry) const;
+
+    std::string GetEntryPath(const AssetArchiveEntry& entry) const;
+
+    const std::string& GetArchivePath() const { return archivePath; }
+
+    std::uint32_t GetEntryCount() const { return header->entryCount; }
+
+    // 供批量 IO 按区间读取条目的文件描述符，不支持时返回 -1
+    int GetReadHandle() const { return readHandle; }
+
+private:
+    AssetArchive() = default;
+
+    std::string archivePath;
+    std::shared_ptr<const MappedFile> file;
+    const AssetArchiveHeader* header = nullptr;
+    const AssetArchiveEntry* entries = nullptr;
+    const char* names = nullptr;
+    int readHandle = -1;
+};
+
+// 资源包打包器，供打包工具使用
+class AssetArchiveWriter {
+public:
+    // alignment 必须是 2 的幂
+    explicit AssetArchiveWriter(std::uint32_t alignment = 64);
+
+    // 登记一个文件，archivePath 为包内路径；compress 为 true 时只在压缩后更小的情况下压缩
+    void AddFile(const std::string& archivePath, const std::string& sourcePath, bool compress);
+
+    // 写出资源包，失败时返回 false
+    bool Write(const std::string& outputPath);
+
+private:
+    struct PendingFile {
+        std::string archivePath;
+        std::string sourcePath;
+        bool compress = false;
+    };
+
+    std::uint32_t alignment;
+    std::vector<PendingFile> files;
+};
+
+} // namespace GE
+
+#endif // ASSETARCHIVE_H
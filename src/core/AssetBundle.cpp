@@ -0,0 +1,63 @@
+#include "AssetBundle.h"
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <iostream>
+
+namespace GE {
+
+void AssetManifest::AddAsset(const std::string& path, std::vector<std::string> dependencies, ProcessFunc process) {
+    auto it = assetIndex.find(path);
+    if (it == assetIndex.end()) {
+        assetIndex.emplace(path, assets.size());
+        assets.push_back({ path, std::move(dependencies), std::move(process) });
+        return;
+    }
+
+    Asset& asset = assets[it->second];
+    for (std::string& dependency : dependencies) {
+        if (std::find(asset.dependencies.begin(), asset.dependencies.end(), dependency) == asset.dependencies.end()) {
+            asset.dependencies.push_back(std::move(dependency));
+        }
+    }
+    if (process) {
+        asset.process = std::move(process);
+    }
+}
+
+bool AssetManifest::SetProcess(const std::string& path, ProcessFunc process) {
+    auto it = assetIndex.find(path);
+    if (it == assetIndex.end()) {
+        return false;
+    }
+    assets[it->second].process = std::move(process);
+    return true;
+}
+
+bool AssetManifest::Load(const std::string& manifestPath) {
+    try {
+        YAML::Node root = YAML::LoadFile(manifestPath);
+        const YAML::Node& list = root["assets"];
+        if (!list.IsSequence()) {
+            std::cerr << "资源清单缺少 assets 列表: " << manifestPath << std::endl;
+            return false;
+        }
+        for (const YAML::Node& item : list) {
+            std::vector<std::string> dependencies;
+            if (item["dependencies"]) {
+                dependencies = item["dependencies"].as<std::vector<std::string>>();
+            }
+            AddAsset(item["path"].as<std::string>(), std::move(dependencies));
+        }
+        return true;
+    } catch (const YAML::Exception& e) {
+        std::cerr << "加载资源清单失败: " << manifestPath << " " << e.what() << std::endl;
+        return false;
+    }
+}
+
+AssetBundle::Resource AssetBundle::Get(const std::string& path) const {
+    auto it = assets.find(path);
+    return it != assets.end() ? it->second : nullptr;
+}
+
+} // namespace GE
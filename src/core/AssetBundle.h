@@ -0,0 +1,67 @@
+#ifndef ASSETBUNDLE_H
+#define ASSETBUNDLE_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace GE {
+
+// 资源清单：资源路径、依赖和可选的后处理步骤
+// 依赖只约束后处理顺序，所有资源的读取同时发出；后处理在自身数据和全部依赖的处理结果就绪后执行。
+// 后处理在完成最后一个输入的 IO 线程上执行，耗时的处理应自行投递到任务调度器。
+class AssetManifest {
+public:
+    using Resource = std::shared_ptr<std::vector<char>>;
+    // 参数为资源自身的数据和按声明顺序排列的依赖处理结果，返回处理后的数据，返回空表示处理失败
+    using ProcessFunc = std::function<Resource(Resource data, const std::vector<Resource>& dependencies)>;
+
+    struct Asset {
+        std::string path;
+        std::vector<std::string> dependencies;
+        ProcessFunc process;
+    };
+
+    // 同一路径重复添加时合并依赖并替换后处理步骤；依赖中未添加的路径按无依赖的资源加载
+    void AddAsset(const std::string& path, std::vector<std::string> dependencies = {}, ProcessFunc process = nullptr);
+
+    // 为已添加的资源设置后处理步骤，资源不存在时返回 false
+    bool SetProcess(const std::string& path, ProcessFunc process);
+
+    // 从 YAML 清单文件追加资源，格式为 assets 列表，每项包含 path 和可选的 dependencies
+    bool Load(const std::string& manifestPath);
+
+    const std::vector<Asset>& GetAssets() const { return assets; }
+
+private:
+    std::vector<Asset> assets;
+    std::unordered_map<std::string, std::size_t> assetIndex;
+};
+
+// 一次批量加载的结果
+class AssetBundle {
+public:
+    using Resource = AssetManifest::Resource;
+
+    // 处理后的资源数据，加载或处理失败时为空
+    Resource Get(const std::string& path) const;
+
+    bool Succeeded() const { return failedAssets.empty(); }
+
+    // 读取失败、处理失败或依赖失败的资源
+    const std::vector<std::string>& GetFailedAssets() const { return failedAssets; }
+
+    std::size_t GetAssetCount() const { return assets.size(); }
+
+private:
+    friend class BundleLoad;
+
+    std::unordered_map<std::string, Resource> assets;
+    std::vector<std::string> failedAssets;
+};
+
+} // namespace GE
+
+#endif // ASSETBUNDLE_H
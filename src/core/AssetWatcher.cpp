@@ -0,0 +1,173 @@
+#include "AssetWatcher.h"
+#include "ThreadTopology.h"
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <set>
+
+#ifdef __linux__
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+namespace GE {
+
+namespace {
+#ifdef __linux__
+    constexpr std::uint32_t kWatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE;
+#endif
+}
+
+AssetWatcher::~AssetWatcher() {
+    Stop();
+}
+
+std::string AssetWatcher::NormalizePath(const std::string& path) {
+    std::error_code error;
+    std::filesystem::path absolute = std::filesystem::absolute(path, error);
+    return (error ? std::filesystem::path(path) : absolute).lexically_normal().generic_string();
+}
+
+bool AssetWatcher::Start(const std::string& rootPath, std::chrono::milliseconds debounceTime, ChangeCallback changeCallback) {
+#ifdef __linux__
+    if (IsRunning()) {
+        return false;
+    }
+    std::error_code error;
+    if (!std::filesystem::is_directory(rootPath, error)) {
+        std::cerr << "资源监视目录不存在: " << rootPath << std::endl;
+        return false;
+    }
+
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotifyFd < 0 || wakeFd < 0) {
+        std::cerr << "初始化 inotify 失败: " << std::strerror(errno) << std::endl;
+        Stop();
+        return false;
+    }
+
+    debounce = debounceTime;
+    callback = std::move(changeCallback);
+    AddWatchRecursive(NormalizePath(rootPath));
+    watchThread = std::thread(&AssetWatcher::WatchThreadFunc, this);
+    return true;
+#else
+    (void)rootPath;
+    (void)debounceTime;
+    (void)changeCallback;
+    return false;
+#endif
+}
+
+void AssetWatcher::Stop() {
+#ifdef __linux__
+    if (watchThread.joinable()) {
+        std::uint64_t value = 1;
+        if (write(wakeFd, &value, sizeof(value)) < 0) {
+            std::cerr << "唤醒资源监视线程失败: " << std::strerror(errno) << std::endl;
+        }
+        watchThread.join();
+    }
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+        inotifyFd = -1;
+    }
+    if (wakeFd >= 0) {
+        close(wakeFd);
+        wakeFd = -1;
+    }
+    watchDirectories.clear();
+#endif
+}
+
+void AssetWatcher::AddWatchRecursive(const std::string& directory) {
+#ifdef __linux__
+    int watch = inotify_add_watch(inotifyFd, directory.c_str(), kWatchMask);
+    if (watch < 0) {
+        std::cerr << "无法监视资源目录: " << directory << " " << std::strerror(errno) << std::endl;
+        return;
+    }
+    watchDirectories[watch] = directory;
+
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_directory(error)) {
+            AddWatchRecursive(it->path().generic_string());
+        }
+    }
+#else
+    (void)directory;
+#endif
+}
+
+void AssetWatcher::WatchThreadFunc() {
+#ifdef __linux__
+    ThreadTopology::SetCurrentThreadName("GE Asset Watcher");
+
+    std::set<std::string> pending;
+    alignas(inotify_event) char buffer[16 * 1024];
+    while (true) {
+        pollfd fds[2] = { { wakeFd, POLLIN, 0 }, { inotifyFd, POLLIN, 0 } };
+        // 有未回调的变化时等待静默期结束，否则一直等待
+        int timeout = pending.empty() ? -1 : static_cast<int>(debounce.count());
+        int ready = poll(fds, 2, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "资源监视失败: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            break;
+        }
+
+        if (ready == 0) {
+            std::vector<std::string> changedFiles(pending.begin(), pending.end());
+            pending.clear();
+            if (callback) {
+                callback(changedFiles);
+            }
+            continue;
+        }
+
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* ptr = buffer; ptr < buffer + length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+                ptr += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    std::cerr << "资源监视事件队列溢出，部分变化可能丢失" << std::endl;
+                    continue;
+                }
+                if (event->mask & IN_IGNORED) {
+                    watchDirectories.erase(event->wd);
+                    continue;
+                }
+                auto it = watchDirectories.find(event->wd);
+                if (it == watchDirectories.end() || event->len == 0) {
+                    continue;
+                }
+                std::string path = it->second + "/" + event->name;
+                if (event->mask & IN_ISDIR) {
+                    // 新建或移入的目录需要单独监视
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        AddWatchRecursive(path);
+                    }
+                    continue;
+                }
+                // 只创建还未写入的文件等到 IN_CLOSE_WRITE 再处理
+                if (event->mask & IN_CREATE) {
+                    continue;
+                }
+                pending.insert(std::move(path));
+            }
+        }
+    }
+#endif
+}
+
+} // namespace GE
@@ -0,0 +1,54 @@
+#ifndef ASSETWATCHER_H
+#define ASSETWATCHER_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace GE {
+
+// 递归监视资源目录的文件变化
+// Linux 上基于 inotify；同一批变化在静默 debounce 时长后一次回调，编辑器保存时的多次写入只触发一次。
+// 回调收到规范化的绝对路径，在监视线程上执行。其他平台上 Start 返回 false。
+class AssetWatcher {
+public:
+    using ChangeCallback = std::function<void(const std::vector<std::string>& changedFiles)>;
+
+    AssetWatcher() = default;
+
+    ~AssetWatcher();
+
+    AssetWatcher(const AssetWatcher&) = delete;
+    AssetWatcher& operator=(const AssetWatcher&) = delete;
+
+    bool Start(const std::string& rootPath, std::chrono::milliseconds debounce, ChangeCallback callback);
+
+    void Stop();
+
+    bool IsRunning() const { return watchThread.joinable(); }
+
+    // 与回调中的路径使用相同的规范化规则
+    static std::string NormalizePath(const std::string& path);
+
+private:
+    int inotifyFd = -1;
+    int wakeFd = -1;
+    std::unordered_map<int, std::string> watchDirectories;
+    std::chrono::milliseconds debounce{ 0 };
+    ChangeCallback callback;
+    std::thread watchThread;
+
+
+    void WatchThreadFunc();
+
+
+    void AddWatchRecursive(const std::string& directory);
+};
+
+} // namespace GE
+
+#endif // ASSETWATCHER_H
@@ -1,159 +1,975 @@
-#include "ModuleInterface.h"
-#include <queue>
-#include <thread>
-#include <mutex>
-#include <condition_variable>
-#include <unordered_map>
-#include <future>
-#include <iostream>
+#include "AsyncLoader.h"
+#include "Profiler.h"
+#include "ThreadTopology.h"
+#include "MemoryResource.h"
+#include "Settings.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <deque>
+#include <filesystem>
 #include <fstream>
-#include <memory>
-#include <functional>
-#include <atomic>
+
+#ifdef GE_HAS_IO_URING
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
 
 namespace GE {
 
-class AsyncLoaderModule : public ModuleInterface {
+struct LoadRequest {
+    AsyncLoaderModule* loader = nullptr;
+    std::string resourcePath;
+    AsyncLoaderModule::LoadCallback callback;
+    std::atomic<LoadStatus> status{ LoadStatus::Queued };
+    std::atomic<int> priority{ 0 };
+    // 状态变为 Completed 之前写入
+    std::shared_ptr<std::vector<char>> result;
+};
+
+LoadStatus LoadHandle::GetStatus() const {
+    return request ? request->status.load(std::memory_order_acquire) : LoadStatus::Failed;
+}
+
+bool LoadHandle::IsDone() const {
+    LoadStatus status = GetStatus();
+    return status == LoadStatus::Completed || status == LoadStatus::Failed || status == LoadStatus::Cancelled;
+}
+
+int LoadHandle::GetPriority() const {
+    return request ? request->priority.load(std::memory_order_relaxed) : 0;
+}
+
+void LoadHandle::SetPriority(int priority) {
+    if (request) {
+        request->loader->SetLoadPriority(request, priority);
+    }
+}
+
+bool LoadHandle::Cancel() {
+    return request && request->loader->CancelLoad(request);
+}
+
+std::shared_ptr<std::vector<char>> LoadHandle::GetResult() const {
+    if (GetStatus() != LoadStatus::Completed) {
+        return nullptr;
+    }
+    return request->result;
+}
+
+// 一次批量加载的状态，由各个读取回调共同持有
+// 每个资源的 pending 计数包含自身数据和未完成的依赖，减到 0 的线程执行后处理并通知依赖它的资源。
+class BundleLoad : public std::enable_shared_from_this<BundleLoad> {
 public:
-    AsyncLoaderModule() : stopLoading(false) {}
+    using Resource = AssetManifest::Resource;
 
-    // 重写基类的虚方法
-    void initialize() override {
-        unsigned int threadCount = std::thread::hardware_concurrency();
-        if (threadCount == 0) threadCount = 4;
-        for (unsigned int i = 0; i < threadCount; ++i) {
-            loaderThreads.emplace_back(&AsyncLoaderModule::LoaderThreadFunc, this);
+    BundleLoad(const AssetManifest& manifest, AsyncLoaderModule::BundleCallback callback)
+        : callback(std::move(callback)) {
+        std::unordered_map<std::string, std::size_t> indices;
+        auto addNode = [&](const std::string& path) {
+            auto inserted = indices.emplace(path, nodes.size());
+            if (inserted.second) {
+                nodes.emplace_back();
+                nodes.back().path = path;
+            }
+            return inserted.first->second;
+        };
+        for (const AssetManifest::Asset& asset : manifest.GetAssets()) {
+            std::size_t index = addNode(asset.path);
+            nodes[index].process = asset.process;
+            for (const std::string& dependency : asset.dependencies) {
+                std::size_t dependencyIndex = addNode(dependency);
+                nodes[index].dependencies.push_back(dependencyIndex);
+            }
         }
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            for (std::size_t dependency : nodes[i].dependencies) {
+                nodes[dependency].dependents.push_back(i);
+            }
+            nodes[i].pending.store(static_cast<int>(nodes[i].dependencies.size()) + 1, std::memory_order_relaxed);
+        }
+        remaining.store(nodes.size(), std::memory_order_relaxed);
     }
 
-    void shutdown() override {
-        {
-            std::lock_guard<std::mutex> lock(queueMutex);
-            stopLoading = true;
+    void Start(AsyncLoaderModule& loader, int priority) {
+        if (nodes.empty()) {
+            Finish();
+            return;
         }
-        cv.notify_all();
-        for (auto& thread : loaderThreads) {
-            if (thread.joinable()) {
-                thread.join();
+        if (HasCycle()) {
+            std::cerr << "资源清单存在循环依赖，批量加载失败" << std::endl;
+            for (Node& node : nodes) {
+                node.failed = true;
             }
+            Finish();
+            return;
+        }
+        std::shared_ptr<BundleLoad> self = shared_from_this();
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            loader.RequestLoad(nodes[i].path, [self, i](Resource data) { self->OnLoaded(i, std::move(data)); }, priority);
         }
     }
 
-    void onEvent(const std::string& event) override {
-        // 处理事件的逻辑
+private:
+    struct Node {
+        std::string path;
+        AssetManifest::ProcessFunc process;
+        std::vector<std::size_t> dependencies;
+        std::vector<std::size_t> dependents;
+        std::atomic<int> pending{ 0 };
+        // 读取完成时写入原始数据，后处理后替换为处理结果
+        Resource data;
+        bool failed = false;
+    };
+
+    std::deque<Node> nodes;
+    std::atomic<std::size_t> remaining{ 0 };
+    AsyncLoaderModule::BundleCallback callback;
+
+    bool HasCycle() const {
+        std::vector<int> inDegree(nodes.size());
+        std::vector<std::size_t> ready;
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            inDegree[i] = static_cast<int>(nodes[i].dependencies.size());
+            if (inDegree[i] == 0) {
+                ready.push_back(i);
+            }
+        }
+        std::size_t visited = 0;
+        while (!ready.empty()) {
+            std::size_t index = ready.back();
+            ready.pop_back();
+            ++visited;
+            for (std::size_t dependent : nodes[index].dependents) {
+                if (--inDegree[dependent] == 0) {
+                    ready.push_back(dependent);
+                }
+            }
+        }
+        return visited != nodes.size();
     }
 
-    void processTask(const GE::Task& task) override {  // 修正为接受 Task 类型
-        std::string taskData = task.GetData();  // 假设 Task 类有 GetData() 方法返回任务数据
-        std::pair<std::string, std::function<void(std::shared_ptr<std::vector<char>>)>> loadTaskData = ParseLoadTaskData(taskData);
-        auto& [resourcePath, callback] = loadTaskData;
-        if (!resourcePath.empty()) {
-            EnqueueLoadTask(resourcePath, callback);
+    void OnLoaded(std::size_t index, Resource data) {
+        nodes[index].data = std::move(data);
+        Release(index);
+    }
+
+    void Release(std::size_t index) {
+        if (nodes[index].pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Process(index);
         }
     }
 
-    void update() override {  // 添加 update 函数以实现纯虚函数
-        // 可以在此实现更新逻辑，或者留空
-        std::cout << "AsyncLoaderModule updated." << std::endl;
+    void Process(std::size_t index) {
+        Node& node = nodes[index];
+        node.failed = !node.data;
+        // 依赖失败时不执行后处理
+        std::vector<Resource> inputs;
+        inputs.reserve(node.dependencies.size());
+        for (std::size_t dependency : node.dependencies) {
+            node.failed = node.failed || nodes[dependency].failed;
+            inputs.push_back(nodes[dependency].data);
+        }
+        if (node.failed) {
+            node.data = nullptr;
+        } else if (node.process) {
+            node.data = node.process(std::move(node.data), inputs);
+            node.failed = !node.data;
+        }
+
+        for (std::size_t dependent : node.dependents) {
+            Release(dependent);
+        }
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Finish();
+        }
     }
 
-    void LoadResourceAsync(const std::string& resourcePath, std::function<void(std::shared_ptr<std::vector<char>>)> callback) {
-        EnqueueLoadTask(resourcePath, callback);
+    void Finish() {
+        auto bundle = std::make_shared<AssetBundle>();
+        for (Node& node : nodes) {
+            bundle->assets[node.path] = node.data;
+            if (node.failed) {
+                bundle->failedAssets.push_back(node.path);
+            }
+        }
+        if (callback) {
+            callback(std::move(bundle));
+        }
     }
+};
 
-private:
-    struct LoadTask {
-        std::string resourcePath;
-        std::function<void(std::shared_ptr<std::vector<char>>)> callback;
-    };
+AsyncLoaderModule::AsyncLoaderModule()
+    : loadQueue(&PoolMemoryResource::GetDefault()),
+      inFlightLoads(&PoolMemoryResource::GetDefault(MemoryTag::Resources)),
+      stopLoading(false),
+      resourceCache(static_cast<std::size_t>(std::max(Settings::Get().GetInt("assets.cache_budget_mb", 512), 0)) * 1024 * 1024),
+      mappedFiles(&PoolMemoryResource::GetDefault(MemoryTag::Resources)),
+      loadStats(&PoolMemoryResource::GetDefault(MemoryTag::Resources)) {}
+
+struct AsyncLoaderModule::PendingRead {
+    LoadTask task;
+    // 不使用固定缓冲区时直接读入结果缓冲区
+    std::shared_ptr<std::vector<char>> data;
+    // 读取包内条目时持有资源包，fd 属于资源包，完成后不关闭
+    std::shared_ptr<const AssetArchive> archive;
+    int fd = -1;
+    int fixedBuffer = -1;
+    std::uint64_t fileOffset = 0;
+    std::size_t size = 0;
+    std::size_t offset = 0;
+};
+
+void AsyncLoaderModule::initialize() {
+    const Settings& settings = Settings::Get();
+    // 显式配置的 IO 线程数不受核心数限制，IO 线程大部分时间在等待磁盘
+    int configuredThreads = settings.GetInt("performance.io_threads", 0);
+    unsigned int threadCount = configuredThreads > 0 ? static_cast<unsigned int>(configuredThreads)
+                                                     : ThreadTopology::Get().GetThreadCount(ThreadPoolType::IO);
+
+    for (const std::string& archivePath : settings.GetStringList("assets.archives")) {
+        MountArchive(archivePath);
+    }
 
-    std::queue<LoadTask> loadQueue;
-    std::mutex queueMutex;
-    std::condition_variable cv;
-    std::atomic<bool> stopLoading;
+    if (settings.GetBool("assets.hot_reload", false)) {
+        std::chrono::milliseconds debounce(std::max(settings.GetInt("assets.hot_reload_debounce_ms", 100), 0));
+        hotReload = assetWatcher.Start(settings.GetString("assets.asset_path", "./assets/"), debounce,
+                                       [this](const std::vector<std::string>& changedFiles) { ReloadResources(changedFiles); });
+    }
+
+    std::string backend = settings.GetString("performance.io_backend", "auto");
+    if (backend != "threads") {
+        unsigned int queueDepth = static_cast<unsigned int>(std::clamp(settings.GetInt("performance.io_queue_depth", 128), 1, 4096));
+        unsigned int reaperCount = std::min(static_cast<unsigned int>(std::clamp(settings.GetInt("performance.io_reaper_threads", 1), 1, 2)), threadCount);
+        std::size_t bufferSize = static_cast<std::size_t>(std::max(settings.GetInt("performance.io_buffer_kb", 64), 4)) * 1024;
+        unsigned int bufferCount = static_cast<unsigned int>(std::max(settings.GetInt("performance.io_buffer_count", 32), 0));
+        for (unsigned int i = 0; i < reaperCount; ++i) {
+            std::unique_ptr<IoUringQueue> ring = IoUringQueue::Create(queueDepth);
+            if (!ring) {
+                break;
+            }
+            // 注册失败时仍可用普通读取
+            ring->RegisterBuffers(bufferSize, std::min(bufferCount, ring->GetQueueDepth()));
+            ioRings.push_back(std::move(ring));
+        }
+        if (ioRings.empty() && backend == "io_uring") {
+            std::cerr << "io_uring 不可用，使用 IO 线程池加载资源" << std::endl;
+        }
+    }
+
+    if (!ioRings.empty()) {
+        for (unsigned int i = 0; i < ioRings.size(); ++i) {
+            loaderThreads.emplace_back(&AsyncLoaderModule::IoUringThreadFunc, this, i);
+        }
+        return;
+    }
 
-    std::vector<std::thread> loaderThreads;
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        loaderThreads.emplace_back(&AsyncLoaderModule::LoaderThreadFunc, this, i);
+    }
+}
+
+void AsyncLoaderModule::shutdown() {
+    assetWatcher.Stop();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopLoading = true;
+    }
+    cv.notify_all();
+    for (auto& thread : loaderThreads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void AsyncLoaderModule::onEvent(const std::string& event) {
+    // 处理事件的逻辑
+}
+
+void AsyncLoaderModule::processTask(const Task& task) {
+    std::string taskData = task.GetData();  // 假设 Task 类有 GetData() 方法返回任务数据
+    std::pair<std::string, LoadCallback> loadTaskData = ParseLoadTaskData(taskData);
+    auto& [resourcePath, callback] = loadTaskData;
+    if (!resourcePath.empty()) {
+        LoadResourceAsync(resourcePath, callback);
+    }
+}
+
+void AsyncLoaderModule::update() {
+    // 可以在此实现更新逻辑，或者留空
+    std::cout << "AsyncLoaderModule updated." << std::endl;
+}
+
+void AsyncLoaderModule::LoadResourceAsync(const std::string& resourcePath, LoadCallback callback) {
+    RequestLoad(resourcePath, std::move(callback));
+}
+
+LoadHandle AsyncLoaderModule::RequestLoad(const std::string& resourcePath, LoadCallback callback, int priority) {
+    auto request = std::make_shared<LoadRequest>();
+    request->loader = this;
+    request->resourcePath = resourcePath;
+    request->callback = std::move(callback);
+    request->priority.store(priority, std::memory_order_relaxed);
+
+    {
+        std::pmr::string key(resourcePath, loadStats.get_allocator());
+        std::lock_guard<std::mutex> lock(statsMutex);
+        ++loadStats[std::move(key)].requests;
+    }
+
+    std::pmr::string key(resourcePath, inFlightLoads.get_allocator());
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        auto it = inFlightLoads.find(key);
+        if (it != inFlightLoads.end()) {
+            // 合并到在途加载，必要时提高排队位置
+            InFlightLoad& load = it->second;
+            load.requests.push_back(request);
+            if (load.queued) {
+                UpdateQueuedPriority(load);
+            } else {
+                request->status.store(LoadStatus::Loading, std::memory_order_release);
+            }
+            return LoadHandle(std::move(request));
+        }
+
+        LoadTask task;
+        task.resourcePath = resourcePath;
+        task.callback = [this, resourcePath](std::shared_ptr<std::vector<char>> resourceData) {
+            CompleteLoad(resourcePath, std::move(resourceData));
+        };
+        InFlightLoad& load = inFlightLoads[std::move(key)];
+        load.requests.push_back(request);
+        load.position = loadQueue.emplace(QueueKey{ priority, nextSequence++ }, std::move(task)).first;
+        peakQueueDepth = std::max(peakQueueDepth, loadQueue.size());
+    }
+    cv.notify_one();
+    return LoadHandle(std::move(request));
+}
+
+void AsyncLoaderModule::LoadBundleAsync(const AssetManifest& manifest, BundleCallback callback, int priority) {
+    if (hotReload) {
+        for (const AssetManifest::Asset& asset : manifest.GetAssets()) {
+            for (const std::string& dependency : asset.dependencies) {
+                RegisterDependency(asset.path, dependency);
+            }
+        }
+    }
+    auto load = std::make_shared<BundleLoad>(manifest, std::move(callback));
+    load->Start(*this, priority);
+}
+
+void AsyncLoaderModule::SetReloadCallback(ReloadCallback callback) {
+    std::lock_guard<std::mutex> lock(reloadMutex);
+    reloadCallback = std::move(callback);
+}
+
+void AsyncLoaderModule::RegisterDependency(const std::string& resourcePath, const std::string& dependencyPath) {
+    std::lock_guard<std::mutex> lock(reloadMutex);
+    std::vector<std::string>& dependencies = assetDependencies[resourcePath];
+    if (std::find(dependencies.begin(), dependencies.end(), dependencyPath) != dependencies.end()) {
+        return;
+    }
+    dependencies.push_back(dependencyPath);
+    assetDependents[dependencyPath].push_back(resourcePath);
+    TrackWatchedPath(resourcePath);
+    TrackWatchedPath(dependencyPath);
+}
+
+void AsyncLoaderModule::ReloadResources(const std::vector<std::string>& changedFiles) {
+    std::vector<std::string> order;
+    ReloadCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(reloadMutex);
+        // 变化的文件加上所有直接或间接依赖它们的资源
+        std::vector<std::string> affected;
+        std::unordered_map<std::string, int> inDegree;
+        for (const std::string& file : changedFiles) {
+            auto it = watchedPaths.find(AssetWatcher::NormalizePath(file));
+            if (it == watchedPaths.end()) {
+                continue;
+            }
+            for (const std::string& resourcePath : it->second) {
+                if (inDegree.emplace(resourcePath, 0).second) {
+                    affected.push_back(resourcePath);
+                }
+            }
+        }
+        for (std::size_t i = 0; i < affected.size(); ++i) {
+            auto it = assetDependents.find(affected[i]);
+            if (it == assetDependents.end()) {
+                continue;
+            }
+            for (const std::string& dependent : it->second) {
+                if (inDegree.emplace(dependent, 0).second) {
+                    affected.push_back(dependent);
+                }
+            }
+        }
+
+        // 只在受影响的子图内排序，依赖先于依赖它的资源
+        for (const std::string& resourcePath : affected) {
+            auto it = assetDependents.find(resourcePath);
+            if (it == assetDependents.end()) {
+                continue;
+            }
+            for (const std::string& dependent : it->second) {
+                ++inDegree[dependent];
+            }
+        }
+        for (const std::string& resourcePath : affected) {
+            if (inDegree[resourcePath] == 0) {
+                order.push_back(resourcePath);
+            }
+        }
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            auto it = assetDependents.find(order[i]);
+            if (it == assetDependents.end()) {
+                continue;
+            }
+            for (const std::string& dependent : it->second) {
+                if (--inDegree[dependent] == 0) {
+                    order.push_back(dependent);
+                }
+            }
+        }
+        callback = reloadCallback;
+    }
+
+    // 读取成功后才原地替换缓存条目，保留固定计数，仍持有旧数据的使用者不受影响；
+    // 读取失败时保留旧数据，只有文件已被删除时才移除条目
+    for (const std::string& resourcePath : order) {
+        CountResourceRead(resourcePath);
+        std::shared_ptr<std::vector<char>> resourceData = LoadResource(resourcePath);
+        if (resourceData) {
+            StoreCachedResource(resourcePath, resourceData);
+        } else {
+            std::error_code error;
+            if (!std::filesystem::exists(resourcePath, error) && !error) {
+                resourceCache.Erase(resourcePath);
+            }
+        }
+        if (callback) {
+            callback(resourcePath, std::move(resourceData));
+        }
+    }
+}
+
+void AsyncLoaderModule::TrackWatchedPath(const std::string& resourcePath) {
+    std::vector<std::string>& paths = watchedPaths[AssetWatcher::NormalizePath(resourcePath)];
+    if (std::find(paths.begin(), paths.end(), resourcePath) == paths.end()) {
+        paths.push_back(resourcePath);
+    }
+}
 
-    std::unordered_map<std::string, std::shared_ptr<std::vector<char>>> resourceCache;
-    std::mutex cacheMutex;
+AsyncLoaderModule::LoadStats AsyncLoaderModule::GetLoadStats(const std::string& resourcePath) {
+    std::pmr::string key(resourcePath, loadStats.get_allocator());
+    std::lock_guard<std::mutex> lock(statsMutex);
+    auto it = loadStats.find(key);
+    return it != loadStats.end() ? it->second : LoadStats();
+}
 
-    void EnqueueLoadTask(const std::string& resourcePath, std::function<void(std::shared_ptr<std::vector<char>>)> callback) {
+std::size_t AsyncLoaderModule::GetInFlightLoadCount() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return inFlightLoads.size();
+}
+
+std::size_t AsyncLoaderModule::GetPeakQueueDepth() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return peakQueueDepth;
+}
+
+void AsyncLoaderModule::ResetPeakQueueDepth() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    peakQueueDepth = loadQueue.size();
+}
+
+void AsyncLoaderModule::LoadResourceViewAsync(const std::string& resourcePath, ViewCallback callback, AccessPattern pattern, int priority) {
+    LoadTask task;
+    task.resourcePath = resourcePath;
+    task.viewCallback = std::move(callback);
+    task.pattern = pattern;
+    EnqueueLoadTask(std::move(task), priority);
+}
+
+ResourceView AsyncLoaderModule::LoadResourceView(const std::string& resourcePath, AccessPattern pattern) {
+    const AssetArchiveEntry* entry = nullptr;
+    if (std::shared_ptr<const AssetArchive> archive = FindArchiveEntry(resourcePath, entry)) {
+        return archive->GetView(*entry, pattern);
+    }
+
+    std::pmr::string cacheKey(resourcePath, mappedFiles.get_allocator());
+    {
+        std::lock_guard<std::mutex> lock(mappedFilesMutex);
+        auto it = mappedFiles.find(cacheKey);
+        if (it != mappedFiles.end()) {
+            if (std::shared_ptr<const MappedFile> file = it->second.lock()) {
+                file->Advise(pattern);
+                return ResourceView(std::move(file));
+            }
+            mappedFiles.erase(it);
+        }
+    }
+
+    std::shared_ptr<const MappedFile> file = MappedFile::Open(resourcePath, pattern);
+    if (!file) {
+        return ResourceView();
+    }
+    {
+        // 两个线程同时映射同一个文件时保留先登记的映射
+        std::lock_guard<std::mutex> lock(mappedFilesMutex);
+        std::weak_ptr<const MappedFile>& entry = mappedFiles[std::move(cacheKey)];
+        if (std::shared_ptr<const MappedFile> existing = entry.lock()) {
+            return ResourceView(std::move(existing));
+        }
+        entry = file;
+    }
+    return ResourceView(std::move(file));
+}
+
+bool AsyncLoaderModule::MountArchive(const std::string& archivePath) {
+    std::shared_ptr<const AssetArchive> archive = AssetArchive::Open(archivePath);
+    if (!archive) {
+        return false;
+    }
+    std::cout << "挂载资源包: " << archivePath << " (" << archive->GetEntryCount() << " 个条目)" << std::endl;
+    std::lock_guard<std::mutex> lock(archiveMutex);
+    archives.push_back(std::move(archive));
+    return true;
+}
+
+void AsyncLoaderModule::EnqueueLoadTask(LoadTask task, int priority) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        loadQueue.emplace(QueueKey{ priority, nextSequence++ }, std::move(task));
+        peakQueueDepth = std::max(peakQueueDepth, loadQueue.size());
+    }
+    cv.notify_one();
+}
+
+AsyncLoaderModule::LoadTask AsyncLoaderModule::PopLoadTask() {
+    auto first = loadQueue.begin();
+    LoadTask task = std::move(first->second);
+    loadQueue.erase(first);
+
+    if (!task.viewCallback) {
+        std::pmr::string key(task.resourcePath, inFlightLoads.get_allocator());
+        auto it = inFlightLoads.find(key);
+        if (it != inFlightLoads.end()) {
+            it->second.queued = false;
+            for (const std::shared_ptr<LoadRequest>& request : it->second.requests) {
+                LoadStatus expected = LoadStatus::Queued;
+                request->status.compare_exchange_strong(expected, LoadStatus::Loading, std::memory_order_acq_rel);
+            }
+        }
+    }
+    return task;
+}
+
+void AsyncLoaderModule::UpdateQueuedPriority(InFlightLoad& load) {
+    int priority = load.requests.front()->priority.load(std::memory_order_relaxed);
+    for (const std::shared_ptr<LoadRequest>& request : load.requests) {
+        priority = std::max(priority, request->priority.load(std::memory_order_relaxed));
+    }
+    if (priority == load.position->first.priority) {
+        return;
+    }
+    // 取出节点修改键后重新插入，不复制任务；保留原序号使同优先级内仍按提交顺序
+    auto node = loadQueue.extract(load.position);
+    node.key().priority = priority;
+    load.position = loadQueue.insert(std::move(node)).position;
+}
+
+bool AsyncLoaderModule::CancelLoad(const std::shared_ptr<LoadRequest>& request) {
+    std::pmr::string key(request->resourcePath, inFlightLoads.get_allocator());
+    std::lock_guard<std::mutex> lock(queueMutex);
+    LoadStatus status = request->status.load(std::memory_order_acquire);
+    while (status == LoadStatus::Queued || status == LoadStatus::Loading) {
+        if (request->status.compare_exchange_weak(status, LoadStatus::Cancelled, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+    if (status != LoadStatus::Queued && status != LoadStatus::Loading) {
+        return false;
+    }
+
+    auto it = inFlightLoads.find(key);
+    if (it != inFlightLoads.end()) {
+        InFlightLoad& load = it->second;
+        load.requests.erase(std::remove(load.requests.begin(), load.requests.end(), request), load.requests.end());
+        if (load.queued) {
+            // 没有请求等待时连同排队任务一起移除，否则按剩余请求重新排队
+            if (load.requests.empty()) {
+                loadQueue.erase(load.position);
+                inFlightLoads.erase(it);
+            } else {
+                UpdateQueuedPriority(load);
+            }
+        }
+    }
+    return true;
+}
+
+void AsyncLoaderModule::SetLoadPriority(const std::shared_ptr<LoadRequest>& request, int priority) {
+    std::pmr::string key(request->resourcePath, inFlightLoads.get_allocator());
+    std::lock_guard<std::mutex> lock(queueMutex);
+    request->priority.store(priority, std::memory_order_relaxed);
+    auto it = inFlightLoads.find(key);
+    if (it != inFlightLoads.end() && it->second.queued && !it->second.requests.empty()) {
+        UpdateQueuedPriority(it->second);
+    }
+}
+
+void AsyncLoaderModule::LoaderThreadFunc(unsigned int index) {
+    ThreadTopology::Get().PinCurrentThread(ThreadPoolType::IO, index);
+    ThreadTopology::SetCurrentThreadName("GE Loader " + std::to_string(index));
+
+    while (true) {
+        LoadTask task;
         {
-            std::lock_guard<std::mutex> lock(queueMutex);
-            loadQueue.push({ resourcePath, callback });
+            std::unique_lock<std::mutex> lock(queueMutex);
+            cv.wait(lock, [this]() { return stopLoading.load() || !loadQueue.empty(); });
+
+            if (stopLoading.load() && loadQueue.empty()) {
+                break;
+            }
+
+            task = PopLoadTask();
+        }
+
+        RunLoadTask(task);
+    }
+}
+
+void AsyncLoaderModule::RunLoadTask(LoadTask& task) {
+    GE_PROFILE_ZONE("Load Resource");
+    if (task.viewCallback) {
+        task.viewCallback(LoadResourceView(task.resourcePath, task.pattern));
+        return;
+    }
+
+    std::shared_ptr<std::vector<char>> resourceData = FindCachedResource(task.resourcePath);
+    if (!resourceData) {
+        CountResourceRead(task.resourcePath);
+        const AssetArchiveEntry* entry = nullptr;
+        if (std::shared_ptr<const AssetArchive> archive = FindArchiveEntry(task.resourcePath, entry)) {
+            resourceData = archive->Read(*entry);
+        } else {
+            resourceData = LoadResource(task.resourcePath);
         }
-        cv.notify_one();
+        if (resourceData) {
+            StoreCachedResource(task.resourcePath, resourceData);
+        }
+    }
+
+    if (task.callback) {
+        task.callback(resourceData);
+    }
+}
+
+void AsyncLoaderModule::IoUringThreadFunc(unsigned int index) {
+    ThreadTopology::Get().PinCurrentThread(ThreadPoolType::IO, index);
+    ThreadTopology::SetCurrentThreadName("GE IO Reaper " + std::to_string(index));
+
+#ifdef GE_HAS_IO_URING
+    IoUringQueue& ring = *ioRings[index];
+    unsigned int queueDepth = ring.GetQueueDepth();
+
+    // user_data 是读取槽下标；每个槽同时最多占用一个提交项，提交队列不会溢出
+    std::vector<PendingRead> reads(queueDepth);
+    std::vector<unsigned int> freeReads;
+    for (unsigned int i = queueDepth; i > 0; --i) {
+        freeReads.push_back(i - 1);
+    }
+    std::vector<int> freeBuffers;
+    for (unsigned int i = ring.GetRegisteredBufferCount(); i > 0; --i) {
+        freeBuffers.push_back(static_cast<int>(i - 1));
     }
+    std::vector<LoadTask> batch;
+    batch.reserve(queueDepth);
+    unsigned int inFlight = 0;
+
+    auto submitRead = [&](unsigned int slot) {
+        PendingRead& read = reads[slot];
+        // 单次读取长度受 32 位限制，剩余部分在完成后继续提交
+        unsigned int length = static_cast<unsigned int>(std::min<std::size_t>(read.size - read.offset, 1u << 30));
+        char* target = read.fixedBuffer >= 0 ? ring.GetRegisteredBuffer(static_cast<unsigned int>(read.fixedBuffer)) : read.data->data();
+        ring.PrepareRead(read.fd, target + read.offset, length, read.fileOffset + read.offset, slot, read.fixedBuffer);
+    };
+
+    auto readBlocking = [&](unsigned int slot) {
+        PendingRead& read = reads[slot];
+        char* target = read.fixedBuffer >= 0 ? ring.GetRegisteredBuffer(static_cast<unsigned int>(read.fixedBuffer)) : read.data->data();
+        while (read.offset < read.size) {
+            ssize_t count = pread(read.fd, target + read.offset, read.size - read.offset, static_cast<off_t>(read.fileOffset + read.offset));
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count <= 0) {
+                // 出错或文件在读取期间被截断
+                read.size = read.offset;
+                return count == 0 && read.size > 0;
+            }
+            read.offset += static_cast<std::size_t>(count);
+        }
+        return true;
+    };
+
+    auto finishRead = [&](unsigned int slot, bool success) {
+        GE_PROFILE_ZONE("Finish Read");
+        PendingRead& read = reads[slot];
+        if (!read.archive) {
+            close(read.fd);
+        }
+        std::shared_ptr<std::vector<char>> resourceData;
+        if (success) {
+            if (read.fixedBuffer >= 0) {
+                const char* buffer = ring.GetRegisteredBuffer(static_cast<unsigned int>(read.fixedBuffer));
+                resourceData = std::make_shared<std::vector<char>>(buffer, buffer + read.size);
+            } else {
+                read.data->resize(read.size);
+                resourceData = std::move(read.data);
+            }
+            StoreCachedResource(read.task.resourcePath, resourceData);
+        } else {
+            std::cerr << "读取资源文件失败: " << read.task.resourcePath << std::endl;
+        }
+        if (read.fixedBuffer >= 0) {
+            freeBuffers.push_back(read.fixedBuffer);
+        }
+
+        LoadTask task = std::move(read.task);
+        read = PendingRead();
+        freeReads.push_back(slot);
+        --inFlight;
+        if (task.callback) {
+            task.callback(resourceData);
+        }
+    };
 
-    void LoaderThreadFunc() {
-        while (true) {
-            LoadTask task;
-            {
-                std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+        {
+            // 有读取在途时不在条件变量上等待，新请求在下一批完成后取走
+            std::unique_lock<std::mutex> lock(queueMutex);
+            if (inFlight == 0) {
                 cv.wait(lock, [this]() { return stopLoading.load() || !loadQueue.empty(); });
+            }
 
-                if (stopLoading.load() && loadQueue.empty()) {
-                    break;
-                }
+            if (stopLoading.load() && loadQueue.empty() && inFlight == 0) {
+                break;
+            }
 
-                task = loadQueue.front();
-                loadQueue.pop();
+            while (!loadQueue.empty() && batch.size() < freeReads.size()) {
+                batch.push_back(PopLoadTask());
             }
+        }
 
-            std::shared_ptr<std::vector<char>> resourceData;
-            {
-                std::lock_guard<std::mutex> lock(cacheMutex);
-                auto it = resourceCache.find(task.resourcePath);
-                if (it != resourceCache.end()) {
-                    resourceData = it->second;
+        bool queued = false;
+        for (LoadTask& task : batch) {
+            // 映射不需要读请求，直接在本线程完成
+            if (task.viewCallback) {
+                RunLoadTask(task);
+                continue;
+            }
+            if (std::shared_ptr<std::vector<char>> cached = FindCachedResource(task.resourcePath)) {
+                if (task.callback) {
+                    task.callback(std::move(cached));
                 }
+                continue;
             }
-
-            if (!resourceData) {
-                resourceData = LoadResource(task.resourcePath);
+            CountResourceRead(task.resourcePath);
+            // 未压缩的包内条目按区间读取资源包，不需要打开文件；压缩条目直接解压
+            const AssetArchiveEntry* entry = nullptr;
+            std::shared_ptr<const AssetArchive> archive = FindArchiveEntry(task.resourcePath, entry);
+            if (archive && ((entry->flags & AssetArchiveEntry::kCompressed) || archive->GetReadHandle() < 0 || entry->size == 0)) {
+                std::shared_ptr<std::vector<char>> resourceData = archive->Read(*entry);
                 if (resourceData) {
-                    std::lock_guard<std::mutex> lock(cacheMutex);
-                    resourceCache[task.resourcePath] = resourceData;
+                    StoreCachedResource(task.resourcePath, resourceData);
+                }
+                if (task.callback) task.callback(std::move(resourceData));
+                continue;
+            }
+
+            int fd = -1;
+            std::uint64_t fileOffset = 0;
+            std::size_t size = 0;
+            if (archive) {
+                fd = archive->GetReadHandle();
+                fileOffset = entry->offset;
+                size = static_cast<std::size_t>(entry->size);
+            } else {
+                fd = open(task.resourcePath.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0) {
+                    std::cerr << "无法打开资源文件: " << task.resourcePath << std::endl;
+                    if (task.callback) task.callback(nullptr);
+                    continue;
+                }
+                struct stat info;
+                if (fstat(fd, &info) != 0 || info.st_size == 0) {
+                    std::cerr << "资源文件为空: " << task.resourcePath << std::endl;
+                    close(fd);
+                    if (task.callback) task.callback(nullptr);
+                    continue;
                 }
+                size = static_cast<std::size_t>(info.st_size);
             }
 
-            if (task.callback) {
-                task.callback(resourceData);
+            unsigned int slot = freeReads.back();
+            freeReads.pop_back();
+            PendingRead& read = reads[slot];
+            read.task = std::move(task);
+            read.archive = std::move(archive);
+            read.fd = fd;
+            read.fileOffset = fileOffset;
+            read.size = size;
+            // 小文件读入固定缓冲区再复制，大文件直接读入结果缓冲区
+            if (!freeBuffers.empty() && read.size <= ring.GetRegisteredBufferSize()) {
+                read.fixedBuffer = freeBuffers.back();
+                freeBuffers.pop_back();
+            } else {
+                read.data = std::make_shared<std::vector<char>>(read.size);
             }
+            ++inFlight;
+            submitRead(slot);
+            queued = true;
         }
-    }
+        batch.clear();
 
-    std::shared_ptr<std::vector<char>> LoadResource(const std::string& resourcePath) {
-        std::ifstream file(resourcePath, std::ios::binary);
-        if (!file.is_open()) {
-            std::cerr << "无法打开资源文件: " << resourcePath << std::endl;
-            return nullptr;
+        // 刚加入新请求时只提交不等待，先处理已经到达的完成事件
+        if (inFlight > 0 && !ring.Submit(queued ? 0 : 1)) {
+            // 队列已不可用，在途请求的状态未知：其缓冲区留在 reads 中直到线程退出，请求改为阻塞读取，
+            // 之后本线程按普通 IO 线程处理加载队列
+            std::cerr << "io_uring 提交失败，改用阻塞读取" << std::endl;
+            for (PendingRead& read : reads) {
+                if (read.fd < 0) {
+                    continue;
+                }
+                if (!read.archive) {
+                    close(read.fd);
+                }
+                read.fd = -1;
+                LoadTask task = std::move(read.task);
+                RunLoadTask(task);
+            }
+            LoaderThreadFunc(index);
+            return;
         }
 
-        file.seekg(0, std::ios::end);
-        size_t size = file.tellg();
-        file.seekg(0, std::ios::beg);
+        std::uint64_t userData;
+        std::int32_t result;
+        while (ring.PopCompletion(userData, result)) {
+            unsigned int slot = static_cast<unsigned int>(userData);
+            PendingRead& read = reads[slot];
+            if (result == -EINTR || result == -EAGAIN) {
+                submitRead(slot);
+            } else if (result == -EINVAL || result == -EOPNOTSUPP) {
+                // 内核或文件系统不支持该读请求，本次改为阻塞读取
+                finishRead(slot, readBlocking(slot));
+            } else if (result < 0) {
+                finishRead(slot, false);
+            } else if (result == 0) {
+                // 文件在读取期间被截断
+                read.size = read.offset;
+                finishRead(slot, read.size > 0);
+            } else {
+                read.offset += static_cast<std::size_t>(result);
+                if (read.offset < read.size) {
+                    submitRead(slot);
+                } else {
+                    finishRead(slot, true);
+                }
+            }
+        }
+    }
+#endif
+}
+
+void AsyncLoaderModule::CompleteLoad(const std::string& resourcePath, std::shared_ptr<std::vector<char>> resourceData) {
+    std::vector<std::shared_ptr<LoadRequest>> requests;
+    {
+        std::pmr::string key(resourcePath, inFlightLoads.get_allocator());
+        std::lock_guard<std::mutex> lock(queueMutex);
+        auto it = inFlightLoads.find(key);
+        if (it != inFlightLoads.end()) {
+            requests = std::move(it->second.requests);
+            inFlightLoads.erase(it);
+        }
+    }
 
-        if (size == 0) {
-            std::cerr << "资源文件为空: " << resourcePath << std::endl;
-            return nullptr;
+    // 回调在锁外执行，回调里可以再次发起加载；与取消竞争失败的请求不再回调
+    LoadStatus finalStatus = resourceData ? LoadStatus::Completed : LoadStatus::Failed;
+    for (const std::shared_ptr<LoadRequest>& request : requests) {
+        request->result = resourceData;
+        LoadStatus expected = LoadStatus::Loading;
+        if (!request->status.compare_exchange_strong(expected, finalStatus, std::memory_order_acq_rel)) {
+            request->result.reset();
+            continue;
         }
+        if (request->callback) {
+            request->callback(resourceData);
+        }
+    }
+}
+
+void AsyncLoaderModule::CountResourceRead(const std::string& resourcePath) {
+    std::pmr::string key(resourcePath, loadStats.get_allocator());
+    std::lock_guard<std::mutex> lock(statsMutex);
+    ++loadStats[std::move(key)].reads;
+}
+
+std::shared_ptr<std::vector<char>> AsyncLoaderModule::FindCachedResource(const std::string& resourcePath) {
+    return resourceCache.Find(resourcePath);
+}
 
-        auto buffer = std::make_shared<std::vector<char>>(size);
-        if (!file.read(buffer->data(), size)) {
-            std::cerr << "读取资源文件失败: " << resourcePath << std::endl;
-            return nullptr;
+void AsyncLoaderModule::StoreCachedResource(const std::string& resourcePath, std::shared_ptr<std::vector<char>> resourceData) {
+    resourceCache.Insert(resourcePath, std::move(resourceData));
+    if (hotReload) {
+        std::lock_guard<std::mutex> lock(reloadMutex);
+        TrackWatchedPath(resourcePath);
+    }
+}
+
+std::shared_ptr<const AssetArchive> AsyncLoaderModule::FindArchiveEntry(const std::string& resourcePath, const AssetArchiveEntry*& entry) {
+    std::lock_guard<std::mutex> lock(archiveMutex);
+    for (auto it = archives.rbegin(); it != archives.rend(); ++it) {
+        if ((entry = (*it)->Find(resourcePath)) != nullptr) {
+            return *it;
         }
+    }
+    return nullptr;
+}
 
-        return buffer;
+std::shared_ptr<std::vector<char>> AsyncLoaderModule::LoadResource(const std::string& resourcePath) {
+    std::ifstream file(resourcePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "无法打开资源文件: " << resourcePath << std::endl;
+        return nullptr;
     }
 
-    std::pair<std::string, std::function<void(std::shared_ptr<std::vector<char>>)>> ParseLoadTaskData(const std::string& data) {
-        std::string resourcePath = data;
-        std::function<void(std::shared_ptr<std::vector<char>>)> callback = nullptr;
-        return { resourcePath, callback };
+    file.seekg(0, std::ios::end);
+    size_t size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    if (size == 0) {
+        std::cerr << "资源文件为空: " << resourcePath << std::endl;
+        return nullptr;
     }
-};
 
-// 动态创建模块
+    auto buffer = std::make_shared<std::vector<char>>(size);
+    if (!file.read(buffer->data(), size)) {
+        std::cerr << "读取资源文件失败: " << resourcePath << std::endl;
+        return nullptr;
+    }
+
+    return buffer;
+}
+
+std::pair<std::string, AsyncLoaderModule::LoadCallback> AsyncLoaderModule::ParseLoadTaskData(const std::string& data) {
+    std::string resourcePath = data;
+    LoadCallback callback = nullptr;
+    return { resourcePath, callback };
+}
+
 }  // 命名空间结束
@@ -2,9 +2,22 @@
 #define ASYNCLOADER_H
 
 #include "ModuleInterface.h"  // 确保 AsyncLoader 继承 ModuleInterface
+#include "MappedFile.h"
+#include "AssetArchive.h"
+#include "AssetBundle.h"
+#include "AssetWatcher.h"
+#include "ResourceCache.h"
+#include "IoUring.h"
+#include <atomic>
+#include <condition_variable>
+#include <map>
 #include <functional>
 #include <string>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <iostream>
 
@@ -44,6 +57,239 @@ namespace GE {
         }
     };
 
+    class AsyncLoaderModule;
+    struct LoadRequest;
+
+    enum class LoadStatus { Queued, Loading, Completed, Failed, Cancelled };
+
+    // 流式加载请求的句柄
+    // 可以查询状态、取消或调整优先级；句柄可以复制，默认构造的句柄无效。
+    class LoadHandle {
+    public:
+        LoadHandle() = default;
+
+        bool IsValid() const { return request != nullptr; }
+
+        LoadStatus GetStatus() const;
+
+        // 已完成、失败或已取消
+        bool IsDone() const;
+
+        int GetPriority() const;
+
+        // 仍在排队时立即调整加载顺序
+        void SetPriority(int priority);
+
+        // 取消后回调不再被调用；请求已经完成时返回 false
+        bool Cancel();
+
+        // 加载完成的数据，未完成或失败时为空
+        std::shared_ptr<std::vector<char>> GetResult() const;
+
+    private:
+        friend class AsyncLoaderModule;
+
+        explicit LoadHandle(std::shared_ptr<LoadRequest> request) : request(std::move(request)) {}
+
+        std::shared_ptr<LoadRequest> request;
+    };
+
+    // 异步资源加载模块
+    // IO 线程池按优先级从队列取加载请求，同优先级先进先出；LoadResourceAsync 返回堆上的副本，
+    // LoadResourceViewAsync 返回直接覆盖内存映射文件的只读视图，不复制数据。
+    // 挂载的资源包优先于散文件：包内路径命中时直接读取包内区间或返回映射切片。
+    // assets.hot_reload 开启时监视 assets.asset_path，文件变化后重新加载它和依赖它的资源，并替换缓存中的条目。
+    // Linux 上可用 io_uring 时由一到两个收割线程批量提交读请求并执行回调，不再为每个阻塞读占用一个线程。
+    class AsyncLoaderModule : public ModuleInterface {
+    public:
+        using LoadCallback = std::function<void(std::shared_ptr<std::vector<char>>)>;
+        using ViewCallback = std::function<void(ResourceView)>;
+
+        AsyncLoaderModule();
+
+        // 重写基类的虚方法
+        void initialize() override;
+
+        void shutdown() override;
+
+        void onEvent(const std::string& event) override;
+
+        void processTask(const Task& task) override;  // 修正为接受 Task 类型
+
+        void update() override;  // 添加 update 函数以实现纯虚函数
+
+        // 同一路径已有加载在途时只登记回调，所有请求由同一次读取完成
+        void LoadResourceAsync(const std::string& resourcePath, LoadCallback callback);
+
+        // 流式加载：priority 越大越先加载，返回的句柄可以取消请求或调整优先级；
+        // 合并到同一路径的请求中，排队位置取最高的优先级
+        LoadHandle RequestLoad(const std::string& resourcePath, LoadCallback callback, int priority = 0);
+
+        using BundleCallback = std::function<void(std::shared_ptr<AssetBundle>)>;
+
+        // 批量加载清单中的全部资源：读取同时排队，后处理按依赖顺序执行，全部结束后调用一次 callback；
+        // 依赖有环时不发起读取，所有资源记为失败
+        void LoadBundleAsync(const AssetManifest& manifest, BundleCallback callback, int priority = 0);
+
+        // 在 IO 线程上映射文件，回调收到覆盖整个文件的视图；失败时视图为空
+        void LoadResourceViewAsync(const std::string& resourcePath, ViewCallback callback,
+                                   AccessPattern pattern = AccessPattern::Sequential, int priority = 0);
+
+        // 同步映射文件，仍被引用的映射会被复用
+        ResourceView LoadResourceView(const std::string& resourcePath, AccessPattern pattern = AccessPattern::Sequential);
+
+        // 挂载资源包，之后的加载先按包内路径查找；后挂载的资源包优先
+        bool MountArchive(const std::string& archivePath);
+
+        // 已加载资源的缓存，预算来自 assets.cache_budget_mb，可用于固定常驻资源或读取命中统计
+        ResourceCache& GetResourceCache() { return resourceCache; }
+
+        // 每个路径的请求次数和实际读取次数，用于确认重复请求被合并
+        struct LoadStats {
+            std::uint64_t requests = 0;
+            std::uint64_t reads = 0;
+        };
+
+        LoadStats GetLoadStats(const std::string& resourcePath);
+
+        std::size_t GetInFlightLoadCount();
+
+        using ReloadCallback = std::function<void(const std::string& resourcePath, std::shared_ptr<std::vector<char>> resourceData)>;
+
+        // 热重载后按依赖顺序通知每个重新加载的资源，依赖先于依赖它的资源；文件被删除时数据为空
+        void SetReloadCallback(ReloadCallback callback);
+
+        // 登记资源依赖，dependencyPath 变化时 resourcePath 同样重新加载；热重载开启时 LoadBundleAsync 自动登记清单中的依赖
+        void RegisterDependency(const std::string& resourcePath, const std::string& dependencyPath);
+
+        // 使变化的文件及依赖它们的资源失效，在当前线程重新读取并替换缓存条目
+        void ReloadResources(const std::vector<std::string>& changedFiles);
+
+        // 加载队列的峰值长度，批量加载时可用来确认读取是否同时排队
+        std::size_t GetPeakQueueDepth();
+
+        void ResetPeakQueueDepth();
+
+    private:
+        friend class LoadHandle;
+
+        struct LoadTask {
+            std::string resourcePath;
+            LoadCallback callback;
+            ViewCallback viewCallback;
+            AccessPattern pattern = AccessPattern::Normal;
+        };
+
+        // 优先级高的在前，同优先级按提交顺序
+        struct QueueKey {
+            int priority = 0;
+            std::uint64_t sequence = 0;
+
+            bool operator<(const QueueKey& other) const {
+                return priority != other.priority ? priority > other.priority : sequence < other.sequence;
+            }
+        };
+
+        using LoadQueue = std::pmr::map<QueueKey, LoadTask>;
+
+        // 同一路径的复制加载共用一个排队任务
+        struct InFlightLoad {
+            std::vector<std::shared_ptr<LoadRequest>> requests;
+            LoadQueue::iterator position;
+            bool queued = true;
+        };
+
+        // 队列节点和映射表的节点、键都从引擎内存池分配
+        LoadQueue loadQueue;
+        std::uint64_t nextSequence = 0;
+        std::size_t peakQueueDepth = 0;
+        // 由 queueMutex 保护
+        std::pmr::unordered_map<std::pmr::string, InFlightLoad> inFlightLoads;
+        std::mutex queueMutex;
+        std::condition_variable cv;
+        std::atomic<bool> stopLoading;
+
+        std::vector<std::thread> loaderThreads;
+
+        // io_uring 后端，每个收割线程一个队列；为空时使用阻塞 IO 线程池
+        std::vector<std::unique_ptr<IoUringQueue>> ioRings;
+
+        // 已提交给 io_uring、尚未完成的读取
+        struct PendingRead;
+
+        ResourceCache resourceCache;
+        // 映射只在仍有视图引用时保留
+        std::pmr::unordered_map<std::pmr::string, std::weak_ptr<const MappedFile>> mappedFiles;
+        std::mutex mappedFilesMutex;
+
+        std::pmr::unordered_map<std::pmr::string, LoadStats> loadStats;
+        std::mutex statsMutex;
+
+        AssetWatcher assetWatcher;
+        bool hotReload = false;
+        // 规范化路径到加载时使用的路径，监视器报告的路径经由它找到缓存键
+        std::unordered_map<std::string, std::vector<std::string>> watchedPaths;
+        std::unordered_map<std::string, std::vector<std::string>> assetDependencies;
+        std::unordered_map<std::string, std::vector<std::string>> assetDependents;
+        ReloadCallback reloadCallback;
+        std::mutex reloadMutex;
+
+        std::vector<std::shared_ptr<const AssetArchive>> archives;
+        std::mutex archiveMutex;
+
+
+        void EnqueueLoadTask(LoadTask task, int priority);
+
+
+        // 取出优先级最高的任务并把对应请求标记为加载中，调用时持有 queueMutex
+        LoadTask PopLoadTask();
+
+
+        // 按在途请求的最高优先级重新排队，调用时持有 queueMutex
+        void UpdateQueuedPriority(InFlightLoad& load);
+
+
+        bool CancelLoad(const std::shared_ptr<LoadRequest>& request);
+
+
+        void SetLoadPriority(const std::shared_ptr<LoadRequest>& request, int priority);
+
+
+        void LoaderThreadFunc(unsigned int index);
+
+
+        void IoUringThreadFunc(unsigned int index);
+
+
+        void RunLoadTask(LoadTask& task);
+
+
+        void CompleteLoad(const std::string& resourcePath, std::shared_ptr<std::vector<char>> resourceData);
+
+
+        void CountResourceRead(const std::string& resourcePath);
+
+
+        // 调用时持有 reloadMutex
+        void TrackWatchedPath(const std::string& resourcePath);
+
+
+        std::shared_ptr<std::vector<char>> FindCachedResource(const std::string& resourcePath);
+
+
+        void StoreCachedResource(const std::string& resourcePath, std::shared_ptr<std::vector<char>> resourceData);
+
+
+        // 在已挂载的资源包中查找，找到时返回资源包并通过 entry 返回条目
+        std::shared_ptr<const AssetArchive> FindArchiveEntry(const std::string& resourcePath, const AssetArchiveEntry*& entry);
+
+
+        std::shared_ptr<std::vector<char>> LoadResource(const std::string& resourcePath);
+
+
+        std::pair<std::string, LoadCallback> ParseLoadTaskData(const std::string& data);
+    };
+
 }
 
 #endif // ASYNCLOADER_H
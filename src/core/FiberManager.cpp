@@ -1,128 +1,398 @@
-#include "ModuleInterface.h"
-#include <functional>
-#include <vector>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
-#include <thread>
-#include <memory>
-#include <atomic>
-#include <iostream>
+#include "FiberManager.h"
+#include "Profiler.h"
+#include "ThreadTopology.h"
+#include "Settings.h"
+#include "MemoryResource.h"
 #include <boost/context/fiber.hpp>
+#include <algorithm>
 #include <nlohmann/json.hpp>
 
 namespace GE {
 
 using json = nlohmann::json;
+using Fiber = boost::context::fiber;
 
-class FiberManagerModule : public ModuleInterface {
-public:
-    FiberManagerModule() : stop(false) {}
+// 可复用的 Fiber：入口函数循环执行分配给它的任务
+struct FiberContext {
+    enum class Action { None, Finished, Yield, Wait };
 
-    void initialize() override {
-        schedulerThread = std::thread(&FiberManagerModule::SchedulerThreadFunc, this);
-        std::cout << "FiberManagerModule initialized." << std::endl;
+    Fiber self;     // 挂起时的 Fiber 续体
+    Fiber caller;   // 运行时所在工作线程的续体
+    boost::context::stack_context stack;
+    FiberStackClass stackClass = FiberStackClass::Small;
+    std::function<void()> job;
+    FiberCounter* counter = nullptr;
+    Action action = Action::None;
+    FiberCounter* waitCounter = nullptr;
+    FiberContext* next = nullptr;
+#ifdef GE_ENABLE_PROFILER
+    Profiler::ZoneStack zones;
+#endif
+};
+
+namespace {
+    thread_local FiberManagerModule* tlsFiberManager = nullptr;
+    thread_local FiberContext* tlsCurrentFiber = nullptr;
+
+
+    // Fiber 可能在另一个线程上恢复，每次都通过函数调用重新读取线程局部变量
+    FiberContext* GetCurrentFiber(const FiberManagerModule* manager) {
+        return tlsFiberManager == manager ? tlsCurrentFiber : nullptr;
     }
+}
 
-    void shutdown() override {
-        {
-            std::lock_guard<std::mutex> lock(queueMutex);
-            stop = true;
+FiberManagerModule::FiberManagerModule()
+    : workerCount(0),
+      fiberTasks(&PoolMemoryResource::GetDefault()),
+      readyFibers(&PoolMemoryResource::GetDefault()),
+      stop(false),
+      paused(false) {}
+
+FiberManagerModule::~FiberManagerModule() {
+    if (!workers.empty()) {
+        shutdown();
+    }
+}
+
+void FiberManagerModule::initialize() {
+    stop = false;
+    workerCount = ThreadTopology::Get().GetThreadCount(ThreadPoolType::Fiber);
+
+    const Settings& settings = Settings::Get();
+    int smallStackKb = settings.GetInt("performance.fiber_small_stack_kb", 64);
+    int largeStackKb = settings.GetInt("performance.fiber_large_stack_kb", 512);
+    int smallCount = std::max(settings.GetInt("performance.fiber_precommit_small", 64), 0);
+    int largeCount = std::max(settings.GetInt("performance.fiber_precommit_large", 4), 0);
+    stackPool = std::make_unique<FiberStackPool>(static_cast<std::size_t>(std::max(smallStackKb, 4)) * 1024,
+                                                 static_cast<std::size_t>(std::max(largeStackKb, 4)) * 1024,
+                                                 settings.GetBool("performance.fiber_track_stack_usage", false));
+    stackPool->Precommit(FiberStackClass::Small, static_cast<std::size_t>(smallCount));
+    stackPool->Precommit(FiberStackClass::Large, static_cast<std::size_t>(largeCount));
+
+    // 预先创建与预提交栈数量相同的 Fiber
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (int i = 0; i < smallCount; ++i) {
+            freeFibers[static_cast<int>(FiberStackClass::Small)].push_back(CreateFiber(FiberStackClass::Small));
         }
-        cv.notify_all();
-        if (schedulerThread.joinable()) {
-            schedulerThread.join();
+        for (int i = 0; i < largeCount; ++i) {
+            freeFibers[static_cast<int>(FiberStackClass::Large)].push_back(CreateFiber(FiberStackClass::Large));
         }
-        std::cout << "FiberManagerModule cleaned up." << std::endl;
     }
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&FiberManagerModule::SchedulerThreadFunc, this, i);
+    }
+    std::cout << "FiberManagerModule initialized with " << workerCount << " threads." << std::endl;
+}
 
-    void onEvent(const std::string& event) override {
-        std::cout << "FiberManager received event: " << event << std::endl;
-        if (event == "pause") {
-            PauseFibers();
-        } else if (event == "resume") {
-            ResumeFibers();
+void FiberManagerModule::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stop = true;
+        paused = false;
+    }
+    cv.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
         }
     }
+    workers.clear();
 
-    void processTask(const Task& task) override {
-        std::cout << "Processing task of type: " << static_cast<int>(task.GetType()) << std::endl;
-        EnqueueFiberTask([=]() {
-            std::cout << "Executing task with data: " << task.GetData() << std::endl;
-        });
+    // 仍在等待计数器的 Fiber 在此销毁，boost.context 会展开其栈
+    readyFibers.clear();
+    for (auto& fibers : freeFibers) {
+        fibers.clear();
     }
+    allFibers.clear();
+    stackPool.reset();
+    std::cout << "FiberManagerModule cleaned up." << std::endl;
+}
 
-    // 重载版本，用于处理字符串任务数据
-    void processTask(const std::string& taskData) {
-        auto fiberFunc = ParseFiberTaskData(taskData);
-        EnqueueFiberTask(fiberFunc);
+void FiberManagerModule::onEvent(const std::string& event) {
+    std::cout << "FiberManager received event: " << event << std::endl;
+    if (event == "pause") {
+        PauseFibers();
+    } else if (event == "resume") {
+        ResumeFibers();
     }
+}
+
+void FiberManagerModule::processTask(const Task& task) {
+    std::cout << "Processing task of type: " << static_cast<int>(task.GetType()) << std::endl;
+    EnqueueFiberTask({ [=]() {
+        std::cout << "Executing task with data: " << task.GetData() << std::endl;
+    }, nullptr, FiberStackClass::Small });
+}
+
+void FiberManagerModule::processTask(const std::string& taskData) {
+    auto fiberFunc = ParseFiberTaskData(taskData);
+    EnqueueFiberTask({ fiberFunc, nullptr, FiberStackClass::Small });
+}
+
+void FiberManagerModule::RunFiber(std::function<void()> fiberFunc, FiberCounter* counter, FiberStackClass stackClass) {
+    if (counter) {
+        counter->Add(1);
+    }
+    EnqueueFiberTask({ std::move(fiberFunc), counter, stackClass });
+}
+
+void FiberManagerModule::YieldFiber() {
+    FiberContext* fiber = GetCurrentFiber(this);
+    if (!fiber) {
+        std::this_thread::yield();
+        return;
+    }
+    fiber->action = FiberContext::Action::Yield;
+    SwitchToScheduler(fiber);
+}
+
+void FiberManagerModule::WaitForCounter(FiberCounter& counter) {
+    FiberContext* fiber = GetCurrentFiber(this);
+    if (!fiber) {
+        RunPendingFibers();
+        std::unique_lock<std::mutex> lock(counter.waitMutex);
+        counter.waitCv.wait(lock, [&counter]() { return counter.IsDone(); });
+        return;
+    }
+    if (counter.IsDone()) {
+        return;
+    }
+    // 真正的挂起在切回工作线程后由 ParkFiber 完成，避免 Fiber 尚未切出就被其他线程恢复
+    fiber->action = FiberContext::Action::Wait;
+    fiber->waitCounter = &counter;
+    SwitchToScheduler(fiber);
+}
+
+void FiberManagerModule::PauseFibers() {
+    std::cout << "Pausing all fibers..." << std::endl;
+    paused = true;
+}
+
+void FiberManagerModule::ResumeFibers() {
+    std::cout << "Resuming all fibers..." << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        paused = false;
+    }
+    cv.notify_all();
+    RunPendingFibers();
+}
+
+bool FiberManagerModule::IsInFiber() const {
+    return GetCurrentFiber(this) != nullptr;
+}
 
-    void RunFiber(std::function<void()> fiberFunc) {
-        EnqueueFiberTask(fiberFunc);
+FiberStackPool::Stats FiberManagerModule::GetStackStats(FiberStackClass stackClass) const {
+    return stackPool ? stackPool->GetStats(stackClass) : FiberStackPool::Stats{ 0, 0, 0, 0 };
+}
+
+void FiberManagerModule::EnqueueFiberTask(FiberTask task) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        fiberTasks.push_back(std::move(task));
     }
+    cv.notify_one();
+    RunPendingFibers();
+}
 
-private:
-    using Fiber = boost::context::fiber;
+void FiberManagerModule::SchedulerThreadFunc(unsigned int index) {
+    ThreadTopology::Get().PinCurrentThread(ThreadPoolType::Fiber, index);
+    ThreadTopology::SetCurrentThreadName("GE Fiber " + std::to_string(index));
+    tlsFiberManager = this;
 
-    std::queue<std::function<void()>> fiberTasks;
-    std::mutex queueMutex;
-    std::condition_variable cv;
-    std::atomic<bool> stop;
+    while (true) {
+        FiberContext* fiber = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            cv.wait(lock, [this]() {
+                return stop.load() || (!paused.load() && (!readyFibers.empty() || !fiberTasks.empty()));
+            });
+            if (stop.load() && readyFibers.empty() && fiberTasks.empty()) {
+                break;
+            }
+            fiber = TakeRunnableFiber();
+        }
+        ExecuteFiber(fiber);
+    }
 
-    std::thread schedulerThread;
+    tlsFiberManager = nullptr;
+}
 
-    void EnqueueFiberTask(std::function<void()> func) {
+void FiberManagerModule::RunPendingFibers() {
+    // 有工作线程，或当前线程已在执行 Fiber 时只入队
+    if (workerCount > 0 || tlsFiberManager == this) {
+        return;
+    }
+    tlsFiberManager = this;
+    while (true) {
+        FiberContext* fiber = nullptr;
         {
             std::lock_guard<std::mutex> lock(queueMutex);
-            fiberTasks.push(func);
+            if (paused.load()) {
+                break;
+            }
+            fiber = TakeRunnableFiber();
+        }
+        if (!fiber) {
+            break;
+        }
+        ExecuteFiber(fiber);
+    }
+    tlsFiberManager = nullptr;
+}
+
+FiberContext* FiberManagerModule::TakeRunnableFiber() {
+    FiberContext* fiber = nullptr;
+    // 两个队列都非空时轮流服务，循环让出的 Fiber 不会饿死它等待的新任务
+    if (!readyFibers.empty() && (fiberTasks.empty() || !startTaskNext)) {
+        fiber = readyFibers.front();
+        readyFibers.pop_front();
+        startTaskNext = true;
+    } else if (!fiberTasks.empty()) {
+        FiberTask& task = fiberTasks.front();
+        auto& candidates = freeFibers[static_cast<int>(task.stackClass)];
+        if (candidates.empty()) {
+            fiber = CreateFiber(task.stackClass);
+        } else {
+            fiber = candidates.back();
+            candidates.pop_back();
         }
-        cv.notify_one();
+        fiber->job = std::move(task.func);
+        fiber->counter = task.counter;
+        fiberTasks.pop_front();
+        startTaskNext = false;
+    }
+    return fiber;
+}
+
+void FiberManagerModule::ExecuteFiber(FiberContext* fiber) {
+    {
+        GE_PROFILE_ZONE("Fiber");
+        RunFiberContext(fiber);
     }
+    ParkFiber(fiber);
+}
 
-    void SchedulerThreadFunc() {
+FiberContext* FiberManagerModule::CreateFiber(FiberStackClass stackClass) {
+    auto context = std::make_unique<FiberContext>();
+    FiberContext* fiber = context.get();
+    fiber->stackClass = stackClass;
+    // 栈取自栈池，Fiber 的控制块也放在栈顶，创建 Fiber 不会再分配堆内存
+    FiberStackAllocator allocator(*stackPool, stackClass, &fiber->stack);
+    fiber->self = Fiber(std::allocator_arg, allocator, [this, fiber](Fiber&& caller) {
+        fiber->caller = std::move(caller);
         while (true) {
-            std::function<void()> taskFunc;
-            {
-                std::unique_lock<std::mutex> lock(queueMutex);
-                cv.wait(lock, [this]() { return stop.load() || !fiberTasks.empty(); });
-                if (stop.load() && fiberTasks.empty()) {
-                    break;
-                }
-                taskFunc = fiberTasks.front();
-                fiberTasks.pop();
+            try {
+                fiber->job();
+            } catch (const std::exception& e) {
+                // 只捕获 std::exception，boost.context 的栈展开异常必须继续传播
+                std::cerr << "Fiber 任务异常: " << e.what() << std::endl;
+            }
+            fiber->job = nullptr;
+            FiberCounter* counter = fiber->counter;
+            fiber->counter = nullptr;
+            if (counter) {
+                SignalCounter(*counter);
             }
+            fiber->action = FiberContext::Action::Finished;
+            fiber->caller = std::move(fiber->caller).resume();
+        }
+        return std::move(fiber->caller);
+    });
+    allFibers.push_back(std::move(context));
+    return fiber;
+}
 
-            Fiber fiber = Fiber([taskFunc](Fiber&& sink) mutable {
-                taskFunc();
-                return std::move(sink);
-            });
+void FiberManagerModule::RunFiberContext(FiberContext* fiber) {
+    fiber->action = FiberContext::Action::None;
+    tlsCurrentFiber = fiber;
+#ifdef GE_ENABLE_PROFILER
+    // Fiber 内的区域不跨越切换：切出时结束，恢复时在当前线程上重新开始
+    Profiler::Get().ResumeZones(fiber->zones);
+#endif
+    fiber->self = std::move(fiber->self).resume();
+#ifdef GE_ENABLE_PROFILER
+    Profiler::Get().SuspendZones();
+#endif
+    tlsCurrentFiber = nullptr;
+}
 
-            while (fiber) {
-                fiber = std::move(fiber).resume();
+void FiberManagerModule::ParkFiber(FiberContext* fiber) {
+    switch (fiber->action) {
+        case FiberContext::Action::Finished: {
+            // Fiber 已挂起，此时扫描它的栈不会与其执行冲突
+            stackPool->UpdateHighWaterMark(fiber->stack);
+            std::lock_guard<std::mutex> lock(queueMutex);
+            freeFibers[static_cast<int>(fiber->stackClass)].push_back(fiber);
+            break;
+        }
+        case FiberContext::Action::Yield:
+            MakeReady(fiber);
+            break;
+        case FiberContext::Action::Wait: {
+            FiberCounter* counter = fiber->waitCounter;
+            fiber->waitCounter = nullptr;
+            std::unique_lock<std::mutex> lock(counter->waitMutex);
+            if (counter->IsDone()) {
+                lock.unlock();
+                MakeReady(fiber);
+            } else {
+                fiber->next = counter->waiters;
+                counter->waiters = fiber;
             }
+            break;
         }
+        case FiberContext::Action::None:
+            break;
     }
+}
 
-    void PauseFibers() {
-        std::cout << "Pausing all fibers..." << std::endl;
+void FiberManagerModule::MakeReady(FiberContext* fiber) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        readyFibers.push_back(fiber);
     }
+    cv.notify_one();
+}
 
-    void ResumeFibers() {
-        std::cout << "Resuming all fibers..." << std::endl;
+void FiberManagerModule::SignalCounter(FiberCounter& counter) {
+    int current = counter.value.load(std::memory_order_relaxed);
+    while (current > 1) {
+        if (counter.value.compare_exchange_weak(current, current - 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return;
+        }
     }
 
-    std::function<void()> ParseFiberTaskData(const std::string& data) {
-        json parsedData = json::parse(data);
-        std::string action = parsedData["action"];
-        if (action == "complex_computation") {
-            return []() {
-                std::cout << "Fiber performing complex computation..." << std::endl;
-            };
-        }
+    // 归零只在锁内发生，普通线程的等待者在锁内检查，返回后可以安全销毁计数器
+    std::lock_guard<std::mutex> lock(counter.waitMutex);
+    counter.value.fetch_sub(1, std::memory_order_acq_rel);
+    FiberContext* waiter = counter.waiters;
+    counter.waiters = nullptr;
+    while (waiter) {
+        FiberContext* next = waiter->next;
+        waiter->next = nullptr;
+        MakeReady(waiter);
+        waiter = next;
+    }
+    counter.waitCv.notify_all();
+}
+
+void FiberManagerModule::SwitchToScheduler(FiberContext* fiber) {
+    fiber->caller = std::move(fiber->caller).resume();
+}
+
+std::function<void()> FiberManagerModule::ParseFiberTaskData(const std::string& data) {
+    json parsedData = json::parse(data);
+    std::string action = parsedData["action"];
+    if (action == "complex_computation") {
         return []() {
-            std::cout << "Fiber handling a task..." << std::endl;
+            std::cout << "Fiber performing complex computation..." << std::endl;
         };
     }
-};
+    return []() {
+        std::cout << "Fiber handling a task..." << std::endl;
+    };
+}
+
 } // namespace GE
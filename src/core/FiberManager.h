@@ -1,8 +1,18 @@
 #ifndef FIBERMANAGER_H
 #define FIBERMANAGER_H
 
+#include "ModuleInterface.h"
+#include "FiberStackPool.h"
 #include <functional>
 #include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace GE {
 
@@ -34,6 +44,141 @@ public:
     }
 };
 
+struct FiberContext;
+
+// Fiber 计数器：RunFiber 提交时加一，任务完成时减一
+// 在 Fiber 中 WaitForCounter 会挂起当前 Fiber 而不是阻塞工作线程
+class FiberCounter {
+public:
+    FiberCounter() : value(0) {}
+
+    FiberCounter(const FiberCounter&) = delete;
+    FiberCounter& operator=(const FiberCounter&) = delete;
+
+    void Add(int count) { value.fetch_add(count, std::memory_order_relaxed); }
+
+    bool IsDone() const { return value.load(std::memory_order_acquire) == 0; }
+
+    int GetValue() const { return value.load(std::memory_order_acquire); }
+
+private:
+    friend class FiberManagerModule;
+
+    std::atomic<int> value;
+    std::mutex waitMutex;
+    std::condition_variable waitCv;
+    FiberContext* waiters = nullptr;
+};
+
+// M:N Fiber 任务系统
+// N 个工作线程复用一组 Fiber 执行任务；任务可以让出或等待计数器，
+// 此时 Fiber 被挂起，工作线程转而执行其他任务，挂起的 Fiber 之后可能在其他线程上恢复。
+class FiberManagerModule : public ModuleInterface {
+public:
+    FiberManagerModule();
+    ~FiberManagerModule() override;
+
+    void initialize() override;
+
+    void shutdown() override;
+
+    void onEvent(const std::string& event) override;
+
+    void processTask(const Task& task) override;
+
+    // 重载版本，用于处理字符串任务数据
+    void processTask(const std::string& taskData);
+
+    // 提交 Fiber 任务，counter 非空时在任务完成后递减
+    // 递归较深或栈上缓冲较大的任务应使用 FiberStackClass::Large
+    void RunFiber(std::function<void()> fiberFunc, FiberCounter* counter = nullptr,
+                  FiberStackClass stackClass = FiberStackClass::Small);
+
+    // 当前 Fiber 让出执行权；不在 Fiber 中时让出线程时间片
+    void YieldFiber();
+
+    // 等待计数器归零：在 Fiber 中挂起当前 Fiber，在普通线程上阻塞
+    void WaitForCounter(FiberCounter& counter);
+
+    // 暂停调度：正在运行的 Fiber 执行到下一次让出为止，之后不再恢复或启动任何 Fiber
+    void PauseFibers();
+
+    void ResumeFibers();
+
+    bool IsInFiber() const;
+
+    FiberStackPool::Stats GetStackStats(FiberStackClass stackClass) const;
+
+private:
+    struct FiberTask {
+        std::function<void()> func;
+        FiberCounter* counter;
+        FiberStackClass stackClass;
+    };
+
+    unsigned int workerCount;
+    std::vector<std::thread> workers;
+
+    // 栈池必须晚于 Fiber 销毁
+    std::unique_ptr<FiberStackPool> stackPool;
+
+    // 所有 Fiber 由模块持有，空闲时按栈类别回到 freeFibers 复用
+    std::vector<std::unique_ptr<FiberContext>> allFibers;
+    std::vector<FiberContext*> freeFibers[kFiberStackClassCount];
+
+    // 队列节点从引擎内存池分配
+    std::pmr::deque<FiberTask> fiberTasks;
+    std::pmr::deque<FiberContext*> readyFibers;
+    std::mutex queueMutex;
+    std::condition_variable cv;
+    std::atomic<bool> stop;
+    std::atomic<bool> paused;
+    // 下一次优先启动新任务还是恢复就绪的 Fiber，由 queueMutex 保护
+    bool startTaskNext = false;
+
+
+    void EnqueueFiberTask(FiberTask task);
+
+
+    void SchedulerThreadFunc(unsigned int index);
+
+
+    // 线程预算不足、没有 Fiber 工作线程时，在当前普通线程上执行 Fiber 直到无事可做
+    void RunPendingFibers();
+
+
+    // 取出下一个要运行的 Fiber，调用时持有 queueMutex；没有时返回 nullptr
+    FiberContext* TakeRunnableFiber();
+
+
+    // 运行 Fiber 到其切回，再按其动作安置
+    void ExecuteFiber(FiberContext* fiber);
+
+
+    FiberContext* CreateFiber(FiberStackClass stackClass);
+
+
+    // 在工作线程上运行 Fiber，直到其完成任务、让出或挂起
+    void RunFiberContext(FiberContext* fiber);
+
+
+    // Fiber 切回工作线程后，根据其请求的动作安置它
+    void ParkFiber(FiberContext* fiber);
+
+
+    void MakeReady(FiberContext* fiber);
+
+
+    void SignalCounter(FiberCounter& counter);
+
+
+    // 切回当前工作线程
+    void SwitchToScheduler(FiberContext* fiber);
+
+
+    std::function<void()> ParseFiberTaskData(const std::string& data);
+};
+
 } // namespace GE
 
 #endif // FIBERMANAGER_H
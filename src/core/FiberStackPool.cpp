@@ -0,0 +1,178 @@
+#include "FiberStackPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace GE {
+
+namespace {
+    // 统计栈使用量时用于填充栈的字节
+    constexpr std::uint64_t kStackPattern = 0xCDCDCDCDCDCDCDCDull;
+
+    std::size_t QueryPageSize() {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<std::size_t>(info.dwPageSize);
+#else
+        long size = sysconf(_SC_PAGESIZE);
+        return size > 0 ? static_cast<std::size_t>(size) : 4096;
+#endif
+    }
+
+    std::size_t AlignUp(std::size_t size, std::size_t alignment) {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+}
+
+FiberStackPool::FiberStackPool(std::size_t smallStackSize, std::size_t largeStackSize, bool trackUsage)
+    : pageSize(QueryPageSize()), trackUsage(trackUsage) {
+    classes[static_cast<int>(FiberStackClass::Small)].stackSize = AlignUp(std::max(smallStackSize, pageSize), pageSize);
+    classes[static_cast<int>(FiberStackClass::Large)].stackSize = AlignUp(std::max(largeStackSize, pageSize), pageSize);
+}
+
+FiberStackPool::~FiberStackPool() {
+    for (StackClass& stackClass : classes) {
+        if (stackClass.freeStacks.size() != stackClass.totalStacks) {
+            std::cerr << "FiberStackPool 销毁时仍有 " << stackClass.totalStacks - stackClass.freeStacks.size()
+                      << " 个栈未归还" << std::endl;
+        }
+        for (void* top : stackClass.freeStacks) {
+            UnmapStack(top, stackClass.stackSize);
+        }
+    }
+}
+
+void FiberStackPool::Precommit(FiberStackClass stackClass, std::size_t count) {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    StackClass& target = classes[static_cast<int>(stackClass)];
+    target.freeStacks.reserve(target.freeStacks.size() + count);
+    for (std::size_t i = 0; i < count; ++i) {
+        target.freeStacks.push_back(MapStack(static_cast<int>(stackClass)));
+        ++target.totalStacks;
+    }
+}
+
+boost::context::stack_context FiberStackPool::Allocate(FiberStackClass stackClass) {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    StackClass& source = classes[static_cast<int>(stackClass)];
+
+    void* top;
+    if (!source.freeStacks.empty()) {
+        top = source.freeStacks.back();
+        source.freeStacks.pop_back();
+    } else {
+        // 慢路径：预提交的栈已用完
+        top = MapStack(static_cast<int>(stackClass));
+        ++source.totalStacks;
+    }
+
+    boost::context::stack_context stack;
+    stack.sp = top;
+    stack.size = source.stackSize;
+    return stack;
+}
+
+void FiberStackPool::Deallocate(boost::context::stack_context& stack) {
+    if (trackUsage) {
+        UpdateHighWaterMark(stack);
+    }
+    std::lock_guard<std::mutex> lock(poolMutex);
+    GetClass(stack.sp).freeStacks.push_back(stack.sp);
+}
+
+void FiberStackPool::UpdateHighWaterMark(const boost::context::stack_context& stack) {
+    if (!trackUsage) {
+        return;
+    }
+
+    // 栈向低地址增长，从栈底向上找到第一个被改写的位置
+    const auto* bottom = reinterpret_cast<const std::uint64_t*>(static_cast<const char*>(stack.sp) - stack.size);
+    const auto* top = static_cast<const std::uint64_t*>(stack.sp);
+    const std::uint64_t* current = bottom;
+    while (current < top && *current == kStackPattern) {
+        ++current;
+    }
+    std::size_t used = static_cast<std::size_t>(reinterpret_cast<const char*>(top) - reinterpret_cast<const char*>(current));
+
+    std::lock_guard<std::mutex> lock(poolMutex);
+    StackClass& target = GetClass(stack.sp);
+    if (used > target.highWaterMark) {
+        target.highWaterMark = used;
+        if (used > target.stackSize / 4 * 3) {
+            std::cerr << "Fiber 栈使用量 " << used << " 字节已超过栈大小 " << target.stackSize << " 的 75%" << std::endl;
+        }
+    }
+}
+
+FiberStackPool::Stats FiberStackPool::GetStats(FiberStackClass stackClass) const {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    const StackClass& source = classes[static_cast<int>(stackClass)];
+    return { source.stackSize, source.totalStacks, source.freeStacks.size(), source.highWaterMark };
+}
+
+void* FiberStackPool::MapStack(int stackClass) {
+    std::size_t stackSize = classes[stackClass].stackSize;
+    std::size_t mappingSize = stackSize + pageSize;
+
+#ifdef _WIN32
+    void* base = VirtualAlloc(nullptr, mappingSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!base) {
+        throw std::bad_alloc();
+    }
+    DWORD oldProtect;
+    if (!VirtualProtect(base, pageSize, PAGE_NOACCESS, &oldProtect)) {
+        VirtualFree(base, 0, MEM_RELEASE);
+        throw std::bad_alloc();
+    }
+#else
+    void* base = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (base == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    // 最低处的保护页，栈溢出时直接触发段错误而不是破坏相邻内存；没有保护页的栈不能交给 Fiber 使用
+    if (mprotect(base, pageSize, PROT_NONE) != 0) {
+        munmap(base, mappingSize);
+        throw std::bad_alloc();
+    }
+#endif
+
+    char* bottom = static_cast<char*>(base) + pageSize;
+    if (trackUsage) {
+        auto* words = reinterpret_cast<std::uint64_t*>(bottom);
+        for (std::size_t i = 0; i < stackSize / sizeof(std::uint64_t); ++i) {
+            words[i] = kStackPattern;
+        }
+    }
+    void* top = bottom + stackSize;
+    stackOwners.emplace(top, stackClass);
+    return top;
+}
+
+void FiberStackPool::UnmapStack(void* top, std::size_t stackSize) {
+    void* base = static_cast<char*>(top) - stackSize - pageSize;
+#ifdef _WIN32
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, stackSize + pageSize);
+#endif
+}
+
+FiberStackPool::StackClass& FiberStackPool::GetClass(const void* top) {
+    auto it = stackOwners.find(top);
+    if (it == stackOwners.end()) {
+        throw std::runtime_error("未知的 Fiber 栈");
+    }
+    return classes[it->second];
+}
+
+} // namespace GE
@@ -0,0 +1,102 @@
+#ifndef FIBERSTACKPOOL_H
+#define FIBERSTACKPOOL_H
+
+#include <boost/context/stack_context.hpp>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace GE {
+
+// Fiber 栈类别：普通任务使用小栈，递归较深的任务使用大栈
+enum class FiberStackClass { Small, Large };
+constexpr int kFiberStackClassCount = 2;
+
+// Fiber 栈池
+// 栈直接从系统映射，最低处保留一个不可访问的保护页用于检测栈溢出；
+// 启动时预先提交一批栈，Fiber 销毁后栈回到空闲列表，稳态下创建 Fiber 不再映射或分配内存。
+class FiberStackPool {
+public:
+    struct Stats {
+        std::size_t stackSize;      // 可用栈大小（不含保护页）
+        std::size_t totalStacks;    // 已映射的栈数量
+        std::size_t freeStacks;     // 空闲栈数量
+        std::size_t highWaterMark;  // 观察到的最大栈使用量，未开启统计时为 0
+    };
+
+    FiberStackPool(std::size_t smallStackSize, std::size_t largeStackSize, bool trackUsage);
+    ~FiberStackPool();
+
+    FiberStackPool(const FiberStackPool&) = delete;
+    FiberStackPool& operator=(const FiberStackPool&) = delete;
+
+    // 预先映射并提交 count 个栈
+    void Precommit(FiberStackClass stackClass, std::size_t count);
+
+    boost::context::stack_context Allocate(FiberStackClass stackClass);
+
+    void Deallocate(boost::context::stack_context& stack);
+
+    // 扫描栈上未被改写的填充字节，更新该类别的使用峰值
+    // 只能在栈所属 Fiber 挂起时调用
+    void UpdateHighWaterMark(const boost::context::stack_context& stack);
+
+    bool IsTrackingUsage() const { return trackUsage; }
+
+    Stats GetStats(FiberStackClass stackClass) const;
+
+private:
+    struct StackClass {
+        std::size_t stackSize = 0;      // 可用大小，按页对齐
+        std::size_t totalStacks = 0;
+        std::size_t highWaterMark = 0;
+        std::vector<void*> freeStacks;  // 空闲栈的栈顶地址
+    };
+
+    StackClass classes[kFiberStackClassCount];
+    // 栈顶地址到所属类别的映射，映射栈时记录；两类栈大小相同时不能按大小区分
+    std::unordered_map<const void*, int> stackOwners;
+    std::size_t pageSize;
+    bool trackUsage;
+    mutable std::mutex poolMutex;
+
+
+    // 为 stackClass 映射一个新栈并记录归属，返回栈顶地址
+    void* MapStack(int stackClass);
+
+
+    void UnmapStack(void* top, std::size_t stackSize);
+
+
+    StackClass& GetClass(const void* top);
+};
+
+// 符合 boost.context StackAllocator 概念的轻量句柄，供 boost::context::fiber 构造时使用
+class FiberStackAllocator {
+public:
+    FiberStackAllocator(FiberStackPool& pool, FiberStackClass stackClass,
+                        boost::context::stack_context* allocated = nullptr)
+        : pool(&pool), stackClass(stackClass), allocated(allocated) {}
+
+    boost::context::stack_context allocate() {
+        boost::context::stack_context stack = pool->Allocate(stackClass);
+        if (allocated) {
+            *allocated = stack;
+        }
+        return stack;
+    }
+
+    void deallocate(boost::context::stack_context& stack) {
+        pool->Deallocate(stack);
+    }
+
+private:
+    FiberStackPool* pool;
+    FiberStackClass stackClass;
+    boost::context::stack_context* allocated;
+};
+
+} // namespace GE
+
+#endif // FIBERSTACKPOOL_H
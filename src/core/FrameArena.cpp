@@ -0,0 +1,160 @@
+#include "FrameArena.h"
+#include <algorithm>
+
+namespace GE {
+
+namespace {
+    constexpr std::size_t kChunkAlignment = 64;
+
+    std::atomic<std::uint64_t> nextMemoryId{ 1 };
+
+    // 当前线程最近一次使用的 FrameMemory 及其 arena
+    struct ThreadArenaCache {
+        std::uint64_t memoryId = 0;
+        void* arenas = nullptr;
+    };
+
+    thread_local ThreadArenaCache tlsArenaCache;
+}
+
+FrameArena::FrameArena(std::size_t chunkSize) : current(0), offset(0), chunkSize(std::max<std::size_t>(chunkSize, 1024)) {}
+
+FrameArena::~FrameArena() {
+    for (const Chunk& chunk : chunks) {
+        DestroyChunk(chunk);
+    }
+}
+
+FrameArena::Marker FrameArena::GetMarker() const {
+    return { current, offset };
+}
+
+void FrameArena::Rewind(const Marker& marker) {
+    current = marker.chunk;
+    offset = marker.offset;
+}
+
+void FrameArena::Reset() {
+    if (current > 0) {
+        // 上一轮溢出到了多个块，合并为一个块
+        std::size_t total = 0;
+        for (const Chunk& chunk : chunks) {
+            total += chunk.size;
+            DestroyChunk(chunk);
+        }
+        chunks.clear();
+        chunks.push_back(CreateChunk(total));
+    }
+    current = 0;
+    offset = 0;
+}
+
+std::size_t FrameArena::GetUsedBytes() const {
+    std::size_t used = 0;
+    for (std::size_t i = 0; i < current && i < chunks.size(); ++i) {
+        used += chunks[i].size;
+    }
+    return used + offset;
+}
+
+std::size_t FrameArena::GetCapacity() const {
+    std::size_t capacity = 0;
+    for (const Chunk& chunk : chunks) {
+        capacity += chunk.size;
+    }
+    return capacity;
+}
+
+void* FrameArena::AllocateSlow(std::size_t size, std::size_t alignment) {
+    // 回退后保留的后续块可以直接复用
+    while (current + 1 < chunks.size()) {
+        ++current;
+        offset = 0;
+        const Chunk& chunk = chunks[current];
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunk.data);
+        std::size_t aligned = ((base + alignment - 1) & ~(alignment - 1)) - base;
+        if (aligned + size <= chunk.size) {
+            offset = aligned + size;
+            return chunk.data + aligned;
+        }
+    }
+
+    Chunk chunk = CreateChunk(std::max(chunkSize, size + alignment));
+    chunks.push_back(chunk);
+    current = chunks.size() - 1;
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunk.data);
+    std::size_t aligned = ((base + alignment - 1) & ~(alignment - 1)) - base;
+    offset = aligned + size;
+    return chunk.data + aligned;
+}
+
+FrameArena::Chunk FrameArena::CreateChunk(std::size_t size) {
+    return { static_cast<char*>(::operator new(size, std::align_val_t(kChunkAlignment))), size };
+}
+
+void FrameArena::DestroyChunk(const Chunk& chunk) {
+    ::operator delete(chunk.data, std::align_val_t(kChunkAlignment));
+}
+
+FrameMemory::FrameMemory(std::size_t bufferedFrames, std::size_t chunkSize)
+    : bufferedFrames(std::min(std::max<std::size_t>(bufferedFrames, 2), kMaxBufferedFrames)),
+      chunkSize(chunkSize),
+      memoryId(nextMemoryId.fetch_add(1)),
+      frameNumber(0) {}
+
+FrameMemory::~FrameMemory() = default;
+
+void FrameMemory::BeginFrame() {
+    std::uint64_t next = frameNumber.load(std::memory_order_relaxed) + 1;
+    std::size_t index = static_cast<std::size_t>(next % bufferedFrames);
+    {
+        // 该缓冲帧上一次使用是在 bufferedFrames 帧之前，其数据已不再被引用
+        std::lock_guard<std::mutex> lock(threadMutex);
+        for (auto& entry : threadArenas) {
+            entry.second->arenas[index]->Reset();
+        }
+    }
+    frameNumber.store(next, std::memory_order_release);
+}
+
+FrameArena& FrameMemory::GetThreadArena() {
+    ThreadArenas* arenas;
+    if (tlsArenaCache.memoryId == memoryId) {
+        arenas = static_cast<ThreadArenas*>(tlsArenaCache.arenas);
+    } else {
+        arenas = &RegisterThread();
+        tlsArenaCache.memoryId = memoryId;
+        tlsArenaCache.arenas = arenas;
+    }
+    return *arenas->arenas[frameNumber.load(std::memory_order_acquire) % bufferedFrames];
+}
+
+std::size_t FrameMemory::GetFrameUsedBytes() const {
+    std::size_t index = static_cast<std::size_t>(frameNumber.load(std::memory_order_acquire) % bufferedFrames);
+    std::lock_guard<std::mutex> lock(threadMutex);
+    std::size_t used = 0;
+    for (const auto& entry : threadArenas) {
+        used += entry.second->arenas[index]->GetUsedBytes();
+    }
+    return used;
+}
+
+FrameMemory::ThreadArenas& FrameMemory::RegisterThread() {
+    std::lock_guard<std::mutex> lock(threadMutex);
+    std::thread::id self = std::this_thread::get_id();
+    for (auto& entry : threadArenas) {
+        if (entry.first == self) {
+            return *entry.second;
+        }
+    }
+
+    // arena 在首次分配时才申请内存块
+    auto arenas = std::make_unique<ThreadArenas>();
+    for (std::size_t i = 0; i < bufferedFrames; ++i) {
+        arenas->arenas[i] = std::make_unique<FrameArena>(chunkSize);
+    }
+    threadArenas.emplace_back(self, std::move(arenas));
+    return *threadArenas.back().second;
+}
+
+} // namespace GE
@@ -0,0 +1,172 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GE {
+
+// 线性（栈式）分配器
+// 只支持按指针递增分配、回退到标记和整体重置，不支持单个对象的释放。
+// 不是线程安全的，每个线程使用自己的 FrameArena。
+class FrameArena {
+public:
+    struct Marker {
+        std::size_t chunk;
+        std::size_t offset;
+    };
+
+    explicit FrameArena(std::size_t chunkSize);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // alignment 必须是 2 的幂
+    void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+        if (current < chunks.size()) {
+            const Chunk& chunk = chunks[current];
+            std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunk.data);
+            std::size_t aligned = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+            if (aligned + size <= chunk.size) {
+                offset = aligned + size;
+                return chunk.data + aligned;
+            }
+        }
+        return AllocateSlow(size, alignment);
+    }
+
+    // 在 arena 中构造对象，对象的析构函数不会被调用
+    template<typename T, typename... Args>
+    T* New(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena 不会调用析构函数");
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    T* NewArray(std::size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena 不会调用析构函数");
+        T* result = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        for (std::size_t i = 0; i < count; ++i) {
+            new (result + i) T();
+        }
+        return result;
+    }
+
+    Marker GetMarker() const;
+
+    // 回退到标记处，标记之后分配的内存全部失效
+    void Rewind(const Marker& marker);
+
+    // 释放全部分配；若上一轮用到了多个块，合并为一个足够大的块，使下一轮不再申请内存
+    void Reset();
+
+    std::size_t GetUsedBytes() const;
+
+    std::size_t GetCapacity() const;
+
+private:
+    struct Chunk {
+        char* data;
+        std::size_t size;
+    };
+
+    std::vector<Chunk> chunks;
+    std::size_t current;    // 正在分配的块
+    std::size_t offset;     // 当前块中已用的字节数
+    std::size_t chunkSize;
+
+
+    void* AllocateSlow(std::size_t size, std::size_t alignment);
+
+
+    static Chunk CreateChunk(std::size_t size);
+
+
+    static void DestroyChunk(const Chunk& chunk);
+};
+
+// 回退作用域：析构时把 arena 回退到构造时的位置
+class FrameArenaScope {
+public:
+    explicit FrameArenaScope(FrameArena& arena) : arena(arena), marker(arena.GetMarker()) {}
+    ~FrameArenaScope() { arena.Rewind(marker); }
+
+    FrameArenaScope(const FrameArenaScope&) = delete;
+    FrameArenaScope& operator=(const FrameArenaScope&) = delete;
+
+private:
+    FrameArena& arena;
+    FrameArena::Marker marker;
+};
+
+// 帧内存
+// 每个线程为每个缓冲帧各持有一个 FrameArena，第 N 帧分配的内存在第 N + bufferedFrames - 1 帧结束前保持有效，
+// 使上一帧的数据在构建当前帧时仍可读取。BeginFrame 切换到下一个缓冲帧并整体重置其中所有线程的 arena。
+class FrameMemory {
+public:
+    static constexpr std::size_t kMaxBufferedFrames = 3;
+
+    // bufferedFrames 取 2（双缓冲）或 3（三缓冲）
+    FrameMemory(std::size_t bufferedFrames, std::size_t chunkSize);
+    ~FrameMemory();
+
+    FrameMemory(const FrameMemory&) = delete;
+    FrameMemory& operator=(const FrameMemory&) = delete;
+
+    // 在主线程上、没有任务分配帧内存时调用
+    void BeginFrame();
+
+    // 当前线程在当前帧使用的 arena
+    FrameArena& GetThreadArena();
+
+    void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+        return GetThreadArena().Allocate(size, alignment);
+    }
+
+    template<typename T, typename... Args>
+    T* New(Args&&... args) {
+        return GetThreadArena().New<T>(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    T* NewArray(std::size_t count) {
+        return GetThreadArena().NewArray<T>(count);
+    }
+
+    std::uint64_t GetFrameNumber() const { return frameNumber.load(std::memory_order_acquire); }
+
+    std::size_t GetBufferedFrameCount() const { return bufferedFrames; }
+
+    // 所有线程在当前帧已使用的字节数
+    std::size_t GetFrameUsedBytes() const;
+
+private:
+    struct ThreadArenas {
+        std::unique_ptr<FrameArena> arenas[kMaxBufferedFrames];
+    };
+
+    std::size_t bufferedFrames;
+    std::size_t chunkSize;
+    std::uint64_t memoryId;
+    std::atomic<std::uint64_t> frameNumber;
+
+    // 各线程首次分配时登记，随 FrameMemory 一起销毁
+    std::vector<std::pair<std::thread::id, std::unique_ptr<ThreadArenas>>> threadArenas;
+    mutable std::mutex threadMutex;
+
+
+    ThreadArenas& RegisterThread();
+};
+
+} // namespace GE
+
+#endif // FRAMEARENA_H
@@ -0,0 +1,109 @@
+#ifndef INLINETASK_H
+#define INLINETASK_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace GE {
+
+// 只可移动的任务闭包，64 字节以内的可调用对象直接存放在对象内部，不做堆分配。
+// 超出容量的闭包退化为堆存储，行为与 std::function 相同。
+class InlineTask {
+public:
+    static constexpr std::size_t kInlineSize = 64;
+
+    InlineTask() noexcept : ops(nullptr) {}
+
+    template<typename Func, typename = typename std::enable_if<!std::is_same<typename std::decay<Func>::type, InlineTask>::value>::type>
+    InlineTask(Func&& func) : ops(nullptr) {
+        using Callable = typename std::decay<Func>::type;
+        if constexpr (FitsInline<Callable>()) {
+            new (storage) Callable(std::forward<Func>(func));
+            ops = &InlineModel<Callable>::kOps;
+        } else {
+            *reinterpret_cast<Callable**>(storage) = new Callable(std::forward<Func>(func));
+            ops = &HeapModel<Callable>::kOps;
+        }
+    }
+
+    InlineTask(InlineTask&& other) noexcept : ops(other.ops) {
+        if (ops) {
+            ops->move(storage, other.storage);
+            other.ops = nullptr;
+        }
+    }
+
+    InlineTask& operator=(InlineTask&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            ops = other.ops;
+            if (ops) {
+                ops->move(storage, other.storage);
+                other.ops = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    InlineTask(const InlineTask&) = delete;
+    InlineTask& operator=(const InlineTask&) = delete;
+
+    ~InlineTask() { Reset(); }
+
+    void operator()() { ops->invoke(storage); }
+
+    explicit operator bool() const noexcept { return ops != nullptr; }
+
+    void Reset() noexcept {
+        if (ops) {
+            ops->destroy(storage);
+            ops = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* self);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void* self) noexcept;
+    };
+
+    template<typename Callable>
+    static constexpr bool FitsInline() {
+        return sizeof(Callable) <= kInlineSize
+            && alignof(Callable) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible<Callable>::value;
+    }
+
+    template<typename Callable>
+    struct InlineModel {
+        static void Invoke(void* self) { (*static_cast<Callable*>(self))(); }
+        static void Move(void* dst, void* src) noexcept {
+            new (dst) Callable(std::move(*static_cast<Callable*>(src)));
+            static_cast<Callable*>(src)->~Callable();
+        }
+        static void Destroy(void* self) noexcept { static_cast<Callable*>(self)->~Callable(); }
+        static constexpr Ops kOps{ &Invoke, &Move, &Destroy };
+    };
+
+    template<typename Callable>
+    struct HeapModel {
+        static Callable*& Get(void* self) { return *static_cast<Callable**>(self); }
+        static void Invoke(void* self) { (*Get(self))(); }
+        static void Move(void* dst, void* src) noexcept {
+            *static_cast<Callable**>(dst) = Get(src);
+            Get(src) = nullptr;
+        }
+        static void Destroy(void* self) noexcept { delete Get(self); }
+        static constexpr Ops kOps{ &Invoke, &Move, &Destroy };
+    };
+
+    alignas(std::max_align_t) unsigned char storage[kInlineSize];
+    const Ops* ops;
+};
+
+} // namespace GE
+
+#endif // INLINETASK_H
@@ -0,0 +1,221 @@
+#include "IoUring.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#ifdef GE_HAS_IO_URING
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+namespace GE {
+
+namespace {
+    constexpr std::size_t kBufferAlignment = 4096;
+
+#ifdef GE_HAS_IO_URING
+    unsigned int* RingField(void* ring, unsigned int offset) {
+        return reinterpret_cast<unsigned int*>(static_cast<char*>(ring) + offset);
+    }
+
+    // IORING_OP_READ 等操作码在 5.6 才加入，更早的内核能创建队列但读请求全部返回 -EINVAL；
+    // IORING_REGISTER_PROBE 同样在 5.6 加入，探测失败即视为不支持
+    bool SupportsReadOps(int ringFd) {
+        const unsigned int opCount = 256;
+        std::vector<char> storage(sizeof(io_uring_probe) + opCount * sizeof(io_uring_probe_op), 0);
+        io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+        if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, opCount) != 0) {
+            return false;
+        }
+        for (unsigned int op : { static_cast<unsigned int>(IORING_OP_READ), static_cast<unsigned int>(IORING_OP_READ_FIXED) }) {
+            if (op > probe->last_op || op >= opCount || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+                return false;
+            }
+        }
+        return true;
+    }
+#endif
+}
+
+std::unique_ptr<IoUringQueue> IoUringQueue::Create(unsigned int queueDepth) {
+#ifdef GE_HAS_IO_URING
+    std::unique_ptr<IoUringQueue> queue(new IoUringQueue());
+
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, queueDepth, &params));
+    if (fd < 0) {
+        // 内核过旧或被安全策略禁用
+        return nullptr;
+    }
+    queue->ringFd = fd;
+    queue->queueDepth = params.sq_entries;
+    if (!SupportsReadOps(fd)) {
+        return nullptr;
+    }
+
+    queue->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    queue->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap) {
+        queue->sqRingSize = queue->cqRingSize = std::max(queue->sqRingSize, queue->cqRingSize);
+    }
+
+    void* sqRing = mmap(nullptr, queue->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        return nullptr;
+    }
+    queue->sqRing = sqRing;
+
+    if (singleMap) {
+        queue->cqRing = sqRing;
+    } else {
+        void* cqRing = mmap(nullptr, queue->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            return nullptr;
+        }
+        queue->cqRing = cqRing;
+    }
+
+    queue->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, queue->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return nullptr;
+    }
+    queue->sqes = sqes;
+
+    queue->sqHead = RingField(queue->sqRing, params.sq_off.head);
+    queue->sqTail = RingField(queue->sqRing, params.sq_off.tail);
+    queue->sqMask = RingField(queue->sqRing, params.sq_off.ring_mask);
+    queue->sqArray = RingField(queue->sqRing, params.sq_off.array);
+    queue->cqHead = RingField(queue->cqRing, params.cq_off.head);
+    queue->cqTail = RingField(queue->cqRing, params.cq_off.tail);
+    queue->cqMask = RingField(queue->cqRing, params.cq_off.ring_mask);
+    queue->cqes = static_cast<char*>(queue->cqRing) + params.cq_off.cqes;
+    queue->pendingTail = *queue->sqTail;
+    return queue;
+#else
+    (void)queueDepth;
+    return nullptr;
+#endif
+}
+
+IoUringQueue::~IoUringQueue() {
+#ifdef GE_HAS_IO_URING
+    if (sqes) munmap(sqes, sqesSize);
+    if (cqRing && cqRing != sqRing) munmap(cqRing, cqRingSize);
+    if (sqRing) munmap(sqRing, sqRingSize);
+    // 关闭 ring 时内核同时注销固定缓冲区
+    if (ringFd >= 0) close(ringFd);
+#endif
+    for (char* buffer : buffers) {
+        ::operator delete(buffer, std::align_val_t(kBufferAlignment));
+    }
+}
+
+bool IoUringQueue::RegisterBuffers(std::size_t size, unsigned int count) {
+#ifdef GE_HAS_IO_URING
+    if (!buffers.empty() || count == 0) {
+        return false;
+    }
+    std::vector<iovec> vectors(count);
+    std::vector<char*> allocated(count);
+    for (unsigned int i = 0; i < count; ++i) {
+        allocated[i] = static_cast<char*>(::operator new(size, std::align_val_t(kBufferAlignment)));
+        vectors[i].iov_base = allocated[i];
+        vectors[i].iov_len = size;
+    }
+    if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS, vectors.data(), count) != 0) {
+        std::cerr << "注册 io_uring 固定缓冲区失败: " << std::strerror(errno) << std::endl;
+        for (char* buffer : allocated) {
+            ::operator delete(buffer, std::align_val_t(kBufferAlignment));
+        }
+        return false;
+    }
+    buffers = std::move(allocated);
+    bufferSize = size;
+    return true;
+#else
+    (void)size;
+    (void)count;
+    return false;
+#endif
+}
+
+bool IoUringQueue::PrepareRead(int fd, void* buffer, unsigned int length, std::uint64_t offset, std::uint64_t userData, int fixedBuffer) {
+#ifdef GE_HAS_IO_URING
+    unsigned int head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    if (pendingTail - head >= queueDepth) {
+        return false;
+    }
+    unsigned int index = pendingTail & *sqMask;
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = fixedBuffer >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<std::uint64_t>(buffer);
+    sqe->len = length;
+    sqe->off = offset;
+    sqe->buf_index = fixedBuffer >= 0 ? static_cast<std::uint16_t>(fixedBuffer) : 0;
+    sqe->user_data = userData;
+    sqArray[index] = index;
+    ++pendingTail;
+    ++pendingCount;
+    return true;
+#else
+    (void)fd; (void)buffer; (void)length; (void)offset; (void)userData; (void)fixedBuffer;
+    return false;
+#endif
+}
+
+bool IoUringQueue::Submit(unsigned int waitCount) {
+#ifdef GE_HAS_IO_URING
+    // 发布新的队尾，内核之后才能看到已准备的请求
+    __atomic_store_n(sqTail, pendingTail, __ATOMIC_RELEASE);
+    unsigned int toSubmit = pendingCount;
+    while (true) {
+        int result = static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, waitCount,
+                                              waitCount > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0));
+        if (result >= 0) {
+            pendingCount -= static_cast<unsigned int>(result) < pendingCount ? static_cast<unsigned int>(result) : pendingCount;
+            return true;
+        }
+        // 完成队列已满或内核暂时缺少资源，取走完成事件后重试即可
+        if (errno == EAGAIN || errno == EBUSY) {
+            return true;
+        }
+        if (errno != EINTR) {
+            std::cerr << "io_uring_enter 失败: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+#else
+    (void)waitCount;
+    return false;
+#endif
+}
+
+bool IoUringQueue::PopCompletion(std::uint64_t& userData, std::int32_t& result) {
+#ifdef GE_HAS_IO_URING
+    unsigned int head = *cqHead;
+    if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    const io_uring_cqe* cqe = static_cast<const io_uring_cqe*>(cqes) + (head & *cqMask);
+    userData = cqe->user_data;
+    result = cqe->res;
+    __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+#else
+    (void)userData;
+    (void)result;
+    return false;
+#endif
+}
+
+} // namespace GE
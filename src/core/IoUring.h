@@ -0,0 +1,84 @@
+#ifndef IOURING_H
+#define IOURING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if defined(__linux__) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #define GE_HAS_IO_URING 1
+    #endif
+#endif
+
+namespace GE {
+
+// io_uring 提交/完成队列的最小封装
+// 直接使用内核头文件和系统调用，不依赖 liburing；编译环境或运行时内核不支持（包括没有 IORING_OP_READ 的 5.6 之前内核）时 Create 返回空。
+// 不是线程安全的，每个线程使用自己的队列。
+class IoUringQueue {
+public:
+    static std::unique_ptr<IoUringQueue> Create(unsigned int queueDepth);
+
+    ~IoUringQueue();
+
+    IoUringQueue(const IoUringQueue&) = delete;
+    IoUringQueue& operator=(const IoUringQueue&) = delete;
+
+    // 注册 bufferCount 个大小为 bufferSize 的固定缓冲区，内核不必每次读取都重新锁定页面；
+    // 失败（例如超出 RLIMIT_MEMLOCK）时返回 false，此后只能使用普通读取
+    bool RegisterBuffers(std::size_t bufferSize, unsigned int bufferCount);
+
+    unsigned int GetRegisteredBufferCount() const { return static_cast<unsigned int>(buffers.size()); }
+
+    std::size_t GetRegisteredBufferSize() const { return bufferSize; }
+
+    char* GetRegisteredBuffer(unsigned int index) const { return buffers[index]; }
+
+    unsigned int GetQueueDepth() const { return queueDepth; }
+
+    // 准备一个读请求，fixedBuffer 为固定缓冲区下标，-1 表示 buffer 是普通内存；提交队列已满时返回 false
+    bool PrepareRead(int fd, void* buffer, unsigned int length, std::uint64_t offset, std::uint64_t userData, int fixedBuffer = -1);
+
+    // 一次系统调用提交所有已准备的请求，并至少等待 waitCount 个完成
+    // 内核暂时无法接收（EAGAIN、EBUSY）时不提交并返回 true，取走完成事件后再次调用；返回 false 表示队列不可用
+    bool Submit(unsigned int waitCount);
+
+    // 取出一个完成事件，没有时返回 false
+    bool PopCompletion(std::uint64_t& userData, std::int32_t& result);
+
+private:
+    IoUringQueue() = default;
+
+    int ringFd = -1;
+    unsigned int queueDepth = 0;
+
+    // 内核共享的环形队列
+    void* sqRing = nullptr;
+    std::size_t sqRingSize = 0;
+    void* cqRing = nullptr;
+    std::size_t cqRingSize = 0;
+    void* sqes = nullptr;
+    std::size_t sqesSize = 0;
+
+    unsigned int* sqHead = nullptr;
+    unsigned int* sqTail = nullptr;
+    unsigned int* sqMask = nullptr;
+    unsigned int* sqArray = nullptr;
+    unsigned int* cqHead = nullptr;
+    unsigned int* cqTail = nullptr;
+    unsigned int* cqMask = nullptr;
+    void* cqes = nullptr;
+
+    // 已准备但尚未提交的请求
+    unsigned int pendingTail = 0;
+    unsigned int pendingCount = 0;
+
+    std::vector<char*> buffers;
+    std::size_t bufferSize = 0;
+};
+
+} // namespace GE
+
+#endif // IOURING_H
@@ -0,0 +1,123 @@
+#include "MappedFile.h"
+#include <iostream>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace GE {
+
+namespace {
+#ifndef _WIN32
+    int ToAdvice(AccessPattern pattern) {
+        switch (pattern) {
+            case AccessPattern::Sequential: return MADV_SEQUENTIAL;
+            case AccessPattern::Random:     return MADV_RANDOM;
+            case AccessPattern::WillNeed:   return MADV_WILLNEED;
+            default:                        return MADV_NORMAL;
+        }
+    }
+#endif
+}
+
+std::shared_ptr<MappedFile> MappedFile::Open(const std::string& filePath, AccessPattern pattern) {
+    std::shared_ptr<MappedFile> file(new MappedFile());
+
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                pattern == AccessPattern::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN :
+                                pattern == AccessPattern::Random ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL,
+                                nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        std::cerr << "无法打开资源文件: " << filePath << std::endl;
+        return nullptr;
+    }
+    file->fileHandle = handle;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart == 0) {
+        std::cerr << "资源文件为空: " << filePath << std::endl;
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        std::cerr << "映射资源文件失败: " << filePath << std::endl;
+        return nullptr;
+    }
+    file->mappingHandle = mapping;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        std::cerr << "映射资源文件失败: " << filePath << std::endl;
+        return nullptr;
+    }
+    file->data = static_cast<const char*>(view);
+    file->size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "无法打开资源文件: " << filePath << std::endl;
+        return nullptr;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        std::cerr << "资源文件为空: " << filePath << std::endl;
+        close(fd);
+        return nullptr;
+    }
+
+    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后文件描述符不再需要
+    close(fd);
+    if (view == MAP_FAILED) {
+        std::cerr << "映射资源文件失败: " << filePath << std::endl;
+        return nullptr;
+    }
+    file->data = static_cast<const char*>(view);
+    file->size = static_cast<std::size_t>(info.st_size);
+    file->Advise(pattern);
+#endif
+
+    return file;
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+#else
+    if (data) {
+        munmap(const_cast<char*>(data), size);
+    }
+#endif
+}
+
+void MappedFile::Advise(AccessPattern pattern, std::size_t offset, std::size_t length) const {
+    if (!data || offset >= size) {
+        return;
+    }
+    if (length == 0 || length > size - offset) {
+        length = size - offset;
+    }
+#ifdef _WIN32
+    if (pattern == AccessPattern::WillNeed) {
+        WIN32_MEMORY_RANGE_ENTRY range{ const_cast<char*>(data) + offset, length };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+#else
+    // madvise 要求起始地址按页对齐
+    static const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    std::size_t alignedOffset = offset / pageSize * pageSize;
+    madvise(const_cast<char*>(data) + alignedOffset, length + (offset - alignedOffset), ToAdvice(pattern));
+#endif
+}
+
+} // namespace GE
@@ -0,0 +1,87 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace GE {
+
+// 映射区域的访问模式提示
+enum class AccessPattern { Normal, Sequential, Random, WillNeed };
+
+// 只读内存映射文件
+// 文件内容直接由页缓存提供，不经过堆上的副本；对象销毁时解除映射。
+class MappedFile {
+public:
+    // 映射整个文件，失败时返回空；空文件无法映射，同样返回空
+    static std::shared_ptr<MappedFile> Open(const std::string& filePath, AccessPattern pattern = AccessPattern::Normal);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* GetData() const { return data; }
+
+    std::size_t GetSize() const { return size; }
+
+    // 为 [offset, offset + length) 设置访问模式提示，length 为 0 表示到文件末尾
+    void Advise(AccessPattern pattern, std::size_t offset = 0, std::size_t length = 0) const;
+
+private:
+    MappedFile() = default;
+
+    const char* data = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+// 资源的只读视图：数据指针、长度和保证数据有效的生命周期句柄
+// 视图可以自由复制，最后一个引用映射（或缓冲区）的视图销毁后内存才会释放。
+class ResourceView {
+public:
+    ResourceView() = default;
+
+    ResourceView(const char* data, std::size_t size, std::shared_ptr<const void> owner)
+        : data(data), size(size), owner(std::move(owner)) {}
+
+    // 视图覆盖整个映射文件
+    explicit ResourceView(std::shared_ptr<const MappedFile> file)
+        : data(file ? file->GetData() : nullptr), size(file ? file->GetSize() : 0), owner(std::move(file)) {}
+
+    const char* Data() const { return data; }
+
+    std::size_t Size() const { return size; }
+
+    bool Empty() const { return size == 0; }
+
+    explicit operator bool() const { return data != nullptr; }
+
+    const char* begin() const { return data; }
+
+    const char* end() const { return data + size; }
+
+    // 子视图与原视图共享生命周期句柄，越界部分会被截断
+    ResourceView Subview(std::size_t offset, std::size_t length) const {
+        if (offset >= size) {
+            return ResourceView(data + size, 0, owner);
+        }
+        return ResourceView(data + offset, length < size - offset ? length : size - offset, owner);
+    }
+
+    const std::shared_ptr<const void>& GetOwner() const { return owner; }
+
+private:
+    const char* data = nullptr;
+    std::size_t size = 0;
+    std::shared_ptr<const void> owner;
+};
+
+} // namespace GE
+
+#endif // MAPPEDFILE_H
@@ -1,137 +1,189 @@
-#include "ModuleInterface.h"
-#include <mutex>
-#include <unordered_map>
+#include "MemoryManager.h"
+#include "Settings.h"
 #include <iostream>
-#include <memory>
-#include <tuple>
-#include <vector>  // 修复 'vector' 未解析符号的错误
 
 namespace GE {
 
-// 内存池类
-class MemoryPool {
-public:
-    MemoryPool(size_t blockSize, size_t initialBlocks = 1024)
-        : blockSize(blockSize) {
-        ExpandPool(initialBlocks);
-    }
-
-    ~MemoryPool() {
-        for (void* block : blocks) {
-            ::operator delete(block);
+MemoryManagerModule::MemoryManagerModule() : warningThresholdBytes(0), overBudget(false) {}
+
+MemoryManagerModule::~MemoryManagerModule() {
+    ReleasePools();
+}
+
+MemoryManagerModule& MemoryManagerModule::GetDefault() {
+    static MemoryManagerModule* instance = []() {
+        auto* memoryManager = new MemoryManagerModule();
+        memoryManager->initialize();
+        return memoryManager;
+    }();
+    return *instance;
+}
+
+void MemoryManagerModule::initialize() {
+    warningThresholdBytes = static_cast<std::int64_t>(Settings::Get().GetInt("performance.memory_warning_threshold", 2048)) * 1024 * 1024;
+
+    ReleasePools();
+    MemoryTracker& tracker = MemoryTracker::Get();
+    for (std::size_t tag = 0; tag < kMemoryTagCount; ++tag) {
+        for (std::size_t index = 0; index < MemorySizeClasses::kClassCount; ++index) {
+            std::size_t blockSize = MemorySizeClasses::GetClassSize(index);
+            // 只为通用标签预先申请 slab，其他标签的池在首次分配时才申请
+            std::size_t initialBlocks = static_cast<MemoryTag>(tag) == MemoryTag::General ? MemoryPool::kMinChunkBytes / blockSize : 0;
+            pools.push_back(std::make_unique<MemoryPool>(blockSize, initialBlocks));
+            tracker.RegisterPool(static_cast<MemoryTag>(tag), pools.back().get());
         }
     }
-
-    void* Allocate() {
-        std::lock_guard lock(mutex);
-        if (freeBlocks.empty()) {
-            ExpandPool(blocks.size());
-        }
-        void* ptr = freeBlocks.back();
-        freeBlocks.pop_back();
-        return ptr;
+    std::cout << "Memory Initialized with " << pools.size() << " memory pools" << std::endl;
+}
+
+void MemoryManagerModule::shutdown() {
+    ReleasePools();
+    std::cout << "内存释放." << std::endl;
+}
+
+void MemoryManagerModule::onEvent(const std::string& event) {
+    std::cout << "内存 event: " << event << std::endl;
+}
+
+void MemoryManagerModule::processTask(const Task& task) {
+    std::string operation;
+    size_t size;
+    void* pointer;
+    std::tie(operation, size, pointer) = ParseMemoryTaskData(task.GetData());
+
+    if (operation == "allocate") {
+        void* allocatedPtr = AllocateMemory(size);
+        std::cout << "Allocated memory of size: " << size << std::endl;
     }
-
-    void Deallocate(void* ptr) {
-        std::lock_guard<std::mutex> lock(mutex);
-        freeBlocks.push_back(ptr);
+    else if (operation == "free") {
+        FreeMemory(pointer, size);
+        std::cout << "Freed memory of size: " << size << std::endl;
     }
+}
 
-private:
-    void ExpandPool(size_t count)
-    {
-        for (size_t i = 0; i < count; ++i)
-        {
-            void* block = ::operator new(blockSize);
-            freeBlocks.push_back(block);
-            blocks.push_back(block);
-        }
-    }
+void MemoryManagerModule::update() {
+    CheckBudget();
+}
 
-    size_t blockSize;
-    std::vector<void*> freeBlocks;
-    std::vector<void*> blocks;
-    std::mutex mutex;
-};
-
-// 内存管理模块类，继承自 ModuleInterface
-class MemoryManagerModule : public GE::ModuleInterface {
-public:
-    void initialize() override {
-        pools.emplace(64, std::make_unique<MemoryPool>(64));
-        pools.emplace(256, std::make_unique<MemoryPool>(256));
-        pools.emplace(1024, std::make_unique<MemoryPool>(1024));
-        std::cout << "Memory Initialized with memory pools" << std::endl;
-    }
+void* MemoryManagerModule::AllocateMemory(size_t size) {
+    return AllocateMemory(size, MemoryTag::General);
+}
 
-    void shutdown() override {
-        pools.clear();
-        std::cout << "内存释放." << std::endl;
+void MemoryManagerModule::FreeMemory(void* ptr, size_t size) {
+    FreeMemory(ptr, size, MemoryTag::General);
+}
+
+void* MemoryManagerModule::AllocateMemory(size_t size, MemoryTag tag) {
+    auto pool = GetPool(size, tag);
+    if (pool) {
+        return pool->Allocate();
+    }
+    else {
+        MemoryTracker::RecordAllocation(tag, size);
+        return ::operator new(size);
     }
+}
 
-    void onEvent(const std::string& event) override {
-        std::cout << "内存 event: " << event << std::endl;
+void MemoryManagerModule::FreeMemory(void* ptr, size_t size, MemoryTag tag) {
+    auto pool = GetPool(size, tag);
+    if (pool) {
+        pool->Deallocate(ptr);
+    }
+    else {
+        MemoryTracker::RecordFree(tag, size);
+        ::operator delete(ptr);
     }
+}
 
-    void processTask(const GE::Task& task) override {
-        std::string operation;
-        size_t size;
-        void* pointer;
-        std::tie(operation, size, pointer) = ParseMemoryTaskData(task.GetData());
+MemoryStats MemoryManagerModule::GetMemoryStats() const {
+    return MemoryTracker::Get().Collect();
+}
 
-        if (operation == "allocate") {
-            void* allocatedPtr = AllocateMemory(size);
-            std::cout << "Allocated memory of size: " << size << std::endl;
+std::vector<MemoryManagerModule::PoolStats> MemoryManagerModule::GetPoolStats() const {
+    std::vector<PoolStats> result;
+    if (pools.empty()) {
+        return result;
+    }
+    result.reserve(MemorySizeClasses::kClassCount);
+    for (std::size_t index = 0; index < MemorySizeClasses::kClassCount; ++index) {
+        PoolStats stats{};
+        stats.blockSize = pools[index]->GetBlockSize();
+        for (std::size_t tag = 0; tag < kMemoryTagCount; ++tag) {
+            MemoryPool& pool = *pools[tag * MemorySizeClasses::kClassCount + index];
+            stats.totalBlocks += pool.GetTotalBlocks();
+            stats.usedBlocks += static_cast<std::int64_t>(pool.GetUsedBlocks());
         }
-        else if (operation == "free") {
-            FreeMemory(pointer, size);
-            std::cout << "Freed memory of size: " << size << std::endl;
+        if (stats.totalBlocks > 0) {
+            stats.utilization = static_cast<double>(stats.usedBlocks) / static_cast<double>(stats.totalBlocks);
+            stats.fragmentation = 1.0 - stats.utilization;
         }
+        result.push_back(stats);
     }
+    return result;
+}
 
-    // 更新函数
-    void update() override {
-        std::cout << "MemoryManagerModule update called." << std::endl;
-    }
+void MemoryManagerModule::SetBudgetCallback(BudgetCallback callback) {
+    std::lock_guard<std::mutex> lock(budgetMutex);
+    budgetCallback = std::move(callback);
+}
 
-    void* AllocateMemory(size_t size) {
-        auto pool = GetPool(size);
-        if (pool) {
-            return pool->Allocate();
-        }
-        else {
-            return ::operator new(size);
-        }
-    }
+void MemoryManagerModule::SetMemoryWarningThreshold(std::int64_t thresholdBytes) {
+    std::lock_guard<std::mutex> lock(budgetMutex);
+    warningThresholdBytes = thresholdBytes;
+}
+
+void MemoryManagerModule::CheckBudget() {
+    MemoryStats stats = MemoryTracker::Get().Collect();
 
-    void FreeMemory(void* ptr, size_t size) {
-        auto pool = GetPool(size);
-        if (pool) {
-            pool->Deallocate(ptr);
+    BudgetCallback callback;
+    std::int64_t threshold;
+    bool crossed = false;
+    {
+        std::lock_guard<std::mutex> lock(budgetMutex);
+        threshold = warningThresholdBytes;
+        if (threshold <= 0) {
+            return;
         }
-        else {
-            ::operator delete(ptr);
+        if (!overBudget && stats.totalBytes > threshold) {
+            overBudget = true;
+            crossed = true;
+            callback = budgetCallback;
+        } else if (overBudget && stats.totalBytes < threshold / 10 * 9) {
+            overBudget = false;
         }
     }
 
-private:
-    std::unordered_map<size_t, std::unique_ptr<MemoryPool>> pools;
+    if (!crossed) {
+        return;
+    }
+    if (callback) {
+        callback(stats, threshold);
+    } else {
+        std::cerr << "内存使用 " << stats.totalBytes / (1024 * 1024) << " MB 超过警告阈值 "
+                  << threshold / (1024 * 1024) << " MB" << std::endl;
+    }
+}
 
-    MemoryPool* GetPool(size_t size) {
-        for (auto& [poolSize, pool] : pools) {
-            if (size <= poolSize) {
-                return pool.get();
-            }
-        }
+MemoryPool* MemoryManagerModule::GetPool(size_t size, MemoryTag tag) {
+    if (pools.empty() || !MemorySizeClasses::IsPooled(size)) {
         return nullptr;
     }
+    return pools[static_cast<std::size_t>(tag) * MemorySizeClasses::kClassCount + MemorySizeClasses::GetClassIndex(size)].get();
+}
 
-    std::tuple<std::string, size_t, void*> ParseMemoryTaskData(const std::string& data) {
-        std::string operation = "allocate";  // 假的
-        size_t size = 256;
-        void* pointer = nullptr;
-        return { operation, size, pointer };
+void MemoryManagerModule::ReleasePools() {
+    MemoryTracker& tracker = MemoryTracker::Get();
+    for (const auto& pool : pools) {
+        tracker.UnregisterPool(pool.get());
     }
-};
+    pools.clear();
+}
+
+std::tuple<std::string, size_t, void*> MemoryManagerModule::ParseMemoryTaskData(const std::string& data) {
+    std::string operation = "allocate";  // 假的
+    size_t size = 256;
+    void* pointer = nullptr;
+    return { operation, size, pointer };
+}
 
-} 
+}
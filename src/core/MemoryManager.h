@@ -1,11 +1,16 @@
 #ifndef MEMORYMANAGER_H
 #define MEMORYMANAGER_H
+#include "ModuleInterface.h"
+#include "MemoryPool.h"
+#include "MemoryTracker.h"
 #include <cstddef>
+#include <functional>
 #include <unordered_map>
 #include <memory>
 #include <mutex>
+#include <tuple>
+#include <vector>
 namespace GE {
-    class MemoryPool;
 class Memory {
 public:
     virtual ~Memory() = default;
@@ -39,6 +44,84 @@ private:
     void ExpandPool(std::size_t size, std::size_t count);
 };
 
+
+// 内存管理模块类，继承自 ModuleInterface
+// 不超过 MemorySizeClasses::kMaxSize 的请求由对应大小类别的池分配，更大的请求直接使用 operator new。
+// 每个子系统标签使用自己的一组池，池中的存活块在统计时计入 MemoryTracker，池分配路径上没有统计开销；
+// 更大的请求在分配时计数。总量超过 performance.memory_warning_threshold 时触发预算回调。
+class MemoryManagerModule : public ModuleInterface, public Memory {
+public:
+    // 同一大小类别各标签的池合计
+    struct PoolStats {
+        std::size_t blockSize;
+        std::size_t totalBlocks;        // 已申请的块数
+        std::int64_t usedBlocks;        // 存活的分配数
+        double utilization;             // usedBlocks / totalBlocks
+        double fragmentation;           // 已切分但空闲、不能归还系统的块所占比例：1 - utilization
+    };
+
+    using BudgetCallback = std::function<void(const MemoryStats& stats, std::int64_t thresholdBytes)>;
+
+    MemoryManagerModule();
+
+    ~MemoryManagerModule() override;
+
+    // 进程级的内存管理模块，首次调用时初始化；有意不销毁，进程退出阶段仍然可用
+    static MemoryManagerModule& GetDefault();
+
+    void initialize() override;
+
+    void shutdown() override;
+
+    void onEvent(const std::string& event) override;
+
+    void processTask(const Task& task) override;
+
+    // 更新函数：汇总内存统计并检查预算
+    void update() override;
+
+    void* AllocateMemory(std::size_t size) override;
+
+    void FreeMemory(void* ptr, std::size_t size) override;
+
+    void* AllocateMemory(std::size_t size, MemoryTag tag);
+
+    // tag 必须与分配时相同
+    void FreeMemory(void* ptr, std::size_t size, MemoryTag tag);
+
+    MemoryStats GetMemoryStats() const;
+
+    std::vector<PoolStats> GetPoolStats() const;
+
+    // 总量从阈值以下越过阈值时调用；回落到阈值的 90% 以下后才会再次触发
+    void SetBudgetCallback(BudgetCallback callback);
+
+    void SetMemoryWarningThreshold(std::int64_t thresholdBytes);
+
+private:
+    // 按标签分组，组内按大小类别下标排列
+    std::vector<std::unique_ptr<MemoryPool>> pools;
+
+    std::int64_t warningThresholdBytes;
+    bool overBudget;
+    BudgetCallback budgetCallback;
+    std::mutex budgetMutex;
+
+
+    void CheckBudget();
+
+
+    // tag 的池中能容纳 size 的最小类别，超出最大类别时返回空
+    MemoryPool* GetPool(std::size_t size, MemoryTag tag);
+
+
+    // 从 MemoryTracker 注销并销毁所有池
+    void ReleasePools();
+
+
+    std::tuple<std::string, std::size_t, void*> ParseMemoryTaskData(const std::string& data);
+};
+
 }
 
-#endif //
+#endif // MEMORYMANAGER_H
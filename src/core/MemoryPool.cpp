@@ -0,0 +1,250 @@
+#include "MemoryPool.h"
+#include <algorithm>
+#include <new>
+
+namespace GE {
+
+namespace {
+    constexpr std::size_t kLookupSize = MemorySizeClasses::kMaxSize / MemorySizeClasses::kGranularity + 1;
+
+    constexpr std::array<std::size_t, MemorySizeClasses::kClassCount> BuildSizes() {
+        std::array<std::size_t, MemorySizeClasses::kClassCount> result{};
+        std::size_t index = 0;
+        for (std::size_t size = MemorySizeClasses::kGranularity; size <= 128; size += MemorySizeClasses::kGranularity) {
+            result[index++] = size;
+        }
+        for (std::size_t base = 128; base < MemorySizeClasses::kMaxSize; base *= 2) {
+            for (std::size_t step = 1; step <= 4; ++step) {
+                result[index++] = base + base / 4 * step;
+            }
+        }
+        return result;
+    }
+
+    // 第 i 项为能容纳 i * kGranularity 字节的最小类别
+    constexpr std::array<std::uint8_t, kLookupSize> BuildLookup() {
+        constexpr std::array<std::size_t, MemorySizeClasses::kClassCount> sizes = BuildSizes();
+        std::array<std::uint8_t, kLookupSize> result{};
+        std::size_t index = 0;
+        for (std::size_t slot = 0; slot < kLookupSize; ++slot) {
+            while (sizes[index] < slot * MemorySizeClasses::kGranularity) {
+                ++index;
+            }
+            result[slot] = static_cast<std::uint8_t>(index);
+        }
+        return result;
+    }
+
+    static_assert(BuildSizes()[MemorySizeClasses::kClassCount - 1] == MemorySizeClasses::kMaxSize, "大小类别表与 kClassCount 不一致");
+
+    struct ThreadCache;
+
+    // 存活池和线程缓存的登记表，槽位在池销毁后复用，池 ID 永不复用。
+    // 线程缓存的扩容和弹匣归属的变化都在锁内进行，统计线程持锁读取各线程弹匣中的块数
+    struct PoolRegistry {
+        std::mutex mutex;
+        std::vector<std::pair<std::uint64_t, MemoryPool*>> slots;
+        std::vector<std::size_t> freeSlots;
+        std::vector<ThreadCache*> caches;
+        std::uint64_t nextId = 1;
+    };
+
+    // 有意泄漏，保证线程局部缓存在进程退出阶段析构时登记表仍然有效
+    PoolRegistry& GetRegistry() {
+        static PoolRegistry* registry = new PoolRegistry();
+        return *registry;
+    }
+
+    struct ThreadCache {
+        std::vector<MemoryPool::Magazine> magazines;
+        bool registered = false;
+        // 析构之后同一线程的其他线程局部对象仍可能分配，此后不再登记
+        bool retired = false;
+
+        ~ThreadCache() {
+            PoolRegistry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for (std::size_t slot = 0; slot < magazines.size(); ++slot) {
+                MemoryPool::Magazine& magazine = magazines[slot];
+                std::size_t count = magazine.count.load(std::memory_order_relaxed);
+                if (count == 0 || slot >= registry.slots.size()) {
+                    continue;
+                }
+                // 只归还给仍然存活的同一个池
+                const auto& entry = registry.slots[slot];
+                if (entry.second && entry.first == magazine.poolId) {
+                    entry.second->ReturnBlocks(magazine.blocks, count);
+                }
+                magazine.count.store(0, std::memory_order_relaxed);
+            }
+            registry.caches.erase(std::remove(registry.caches.begin(), registry.caches.end(), this), registry.caches.end());
+            registered = false;
+            retired = true;
+        }
+    };
+
+    thread_local ThreadCache tlsCache;
+}
+
+MemoryPool::Magazine::Magazine(const Magazine& other)
+    : poolId(other.poolId), count(other.count.load(std::memory_order_relaxed)) {
+    std::copy(other.blocks, other.blocks + count.load(std::memory_order_relaxed), blocks);
+}
+
+const std::array<std::size_t, MemorySizeClasses::kClassCount> MemorySizeClasses::sizes = BuildSizes();
+const std::array<std::uint8_t, MemorySizeClasses::kMaxSize / MemorySizeClasses::kGranularity + 1> MemorySizeClasses::lookup = BuildLookup();
+
+MemoryPool::MemoryPool(std::size_t blockSize, std::size_t initialBlocks)
+    : blockSize((std::max(blockSize, sizeof(void*)) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t)),
+      totalBlocks(0) {
+    PoolRegistry& registry = GetRegistry();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        poolId = registry.nextId++;
+        if (!registry.freeSlots.empty()) {
+            slot = registry.freeSlots.back();
+            registry.freeSlots.pop_back();
+            registry.slots[slot] = { poolId, this };
+        } else {
+            slot = registry.slots.size();
+            registry.slots.emplace_back(poolId, this);
+        }
+    }
+    if (initialBlocks > 0) {
+        ExpandPool(initialBlocks);
+    }
+}
+
+MemoryPool::~MemoryPool() {
+    // 先注销，之后线程退出时不会再向本池归还块；各线程弹匣中残留的指针随池失效
+    PoolRegistry& registry = GetRegistry();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.slots[slot] = { 0, nullptr };
+        registry.freeSlots.push_back(slot);
+    }
+    for (void* chunk : chunks) {
+        ::operator delete(chunk, std::align_val_t(kChunkAlignment));
+    }
+}
+
+void* MemoryPool::Allocate() {
+    Magazine& magazine = GetMagazine();
+    // 只有本线程写 count，relaxed 的读写与普通变量生成相同的指令
+    std::size_t count = magazine.count.load(std::memory_order_relaxed);
+    if (count == 0) {
+        Refill(magazine);
+        count = magazine.count.load(std::memory_order_relaxed);
+    }
+    magazine.count.store(--count, std::memory_order_relaxed);
+    return magazine.blocks[count];
+}
+
+void MemoryPool::Deallocate(void* ptr) {
+    Magazine& magazine = GetMagazine();
+    std::size_t count = magazine.count.load(std::memory_order_relaxed);
+    if (count == kMagazineCapacity) {
+        Flush(magazine, kBatchSize);
+        count -= kBatchSize;
+    }
+    magazine.blocks[count] = ptr;
+    magazine.count.store(count + 1, std::memory_order_relaxed);
+}
+
+void MemoryPool::FlushThreadCache() {
+    Magazine& magazine = GetMagazine();
+    std::size_t count = magazine.count.load(std::memory_order_relaxed);
+    if (count > 0) {
+        Flush(magazine, count);
+    }
+}
+
+std::size_t MemoryPool::GetTotalBlocks() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return totalBlocks;
+}
+
+std::size_t MemoryPool::GetUsedBlocks() {
+    PoolRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> registryLock(registry.mutex);
+    // 弹匣与空闲列表之间的交换都持有池的锁，持锁时两者的合计不变
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t cached = 0;
+    for (const ThreadCache* cache : registry.caches) {
+        if (slot < cache->magazines.size() && cache->magazines[slot].poolId == poolId) {
+            cached += cache->magazines[slot].count.load(std::memory_order_relaxed);
+        }
+    }
+    return totalBlocks - freeBlocks.size() - cached;
+}
+
+void MemoryPool::ReturnBlocks(void* const* returned, std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    freeBlocks.insert(freeBlocks.end(), returned, returned + count);
+}
+
+MemoryPool::Magazine& MemoryPool::GetMagazine() {
+    auto& magazines = tlsCache.magazines;
+    if (slot >= magazines.size() || magazines[slot].poolId != poolId) {
+        return AttachMagazine();
+    }
+    return magazines[slot];
+}
+
+MemoryPool::Magazine& MemoryPool::AttachMagazine() {
+    PoolRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    ThreadCache& cache = tlsCache;
+    if (!cache.registered && !cache.retired) {
+        registry.caches.push_back(&cache);
+        cache.registered = true;
+    }
+    if (slot >= cache.magazines.size()) {
+        cache.magazines.resize(slot + 1);
+    }
+    Magazine& magazine = cache.magazines[slot];
+    if (magazine.poolId != poolId) {
+        // 槽位上一个使用者已经销毁，其缓存的块随之失效
+        magazine.poolId = poolId;
+        magazine.count.store(0, std::memory_order_relaxed);
+    }
+    return magazine;
+}
+
+void MemoryPool::Refill(Magazine& magazine) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (freeBlocks.size() < kBatchSize) {
+        ExpandPool(GetNextChunkBlockCount());
+    }
+    std::size_t count = std::min(kBatchSize, freeBlocks.size());
+    std::size_t cached = magazine.count.load(std::memory_order_relaxed);
+    std::copy(freeBlocks.end() - count, freeBlocks.end(), magazine.blocks + cached);
+    freeBlocks.resize(freeBlocks.size() - count);
+    magazine.count.store(cached + count, std::memory_order_relaxed);
+}
+
+void MemoryPool::Flush(Magazine& magazine, std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t cached = magazine.count.load(std::memory_order_relaxed) - count;
+    magazine.count.store(cached, std::memory_order_relaxed);
+    freeBlocks.insert(freeBlocks.end(), magazine.blocks + cached, magazine.blocks + cached + count);
+}
+
+void MemoryPool::ExpandPool(std::size_t count) {
+    char* chunk = static_cast<char*>(::operator new(count * blockSize, std::align_val_t(kChunkAlignment)));
+    chunks.push_back(chunk);
+    totalBlocks += count;
+
+    // 逆序压入，使分配从低地址开始按顺序进行
+    freeBlocks.reserve(freeBlocks.size() + count);
+    for (std::size_t i = count; i > 0; --i) {
+        freeBlocks.push_back(chunk + (i - 1) * blockSize);
+    }
+}
+
+std::size_t MemoryPool::GetNextChunkBlockCount() const {
+    std::size_t bytes = std::min(std::max(totalBlocks * blockSize, kMinChunkBytes), kMaxChunkBytes);
+    return std::max(bytes / blockSize, kBatchSize);
+}
+
+} // namespace GE
@@ -0,0 +1,118 @@
+#ifndef MEMORYPOOL_H
+#define MEMORYPOOL_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace GE {
+
+// 内存池大小类别
+// 128 字节以内按 16 字节递增，之后每个 2 的幂区间再细分为 4 档（间隔 25%），最大 4096 字节。
+// 通过按 16 字节粒度展开的查找表在常数时间内找到能容纳请求的最小类别。
+class MemorySizeClasses {
+public:
+    static constexpr std::size_t kGranularity = 16;
+    static constexpr std::size_t kMaxSize = 4096;
+    static constexpr std::size_t kClassCount = 28;
+
+    // 超过 kMaxSize 时不属于任何类别
+    static bool IsPooled(std::size_t size) { return size <= kMaxSize; }
+
+    static std::size_t GetClassIndex(std::size_t size) {
+        return lookup[(size + kGranularity - 1) / kGranularity];
+    }
+
+    static std::size_t GetClassSize(std::size_t index) { return sizes[index]; }
+
+private:
+    static const std::array<std::size_t, kClassCount> sizes;
+    static const std::array<std::uint8_t, kMaxSize / kGranularity + 1> lookup;
+};
+
+// 固定块大小的内存池
+// 块从按页对齐的大块连续内存（slab）中切分，slab 大小按池容量倍增，上限 kMaxChunkBytes。
+// 每个线程为每个池保留一个弹匣（magazine）缓存空闲块，分配和释放只访问本线程的弹匣；
+// 弹匣为空或已满时才加锁，与共享空闲列表批量交换 kBatchSize 个块。
+// 存活块数由已申请的块数减去空闲列表和各线程弹匣中的块数得到，分配和释放不维护额外的计数。
+class MemoryPool {
+public:
+    static constexpr std::size_t kMagazineCapacity = 64;
+    static constexpr std::size_t kBatchSize = kMagazineCapacity / 2;
+    static constexpr std::size_t kChunkAlignment = 4096;
+    static constexpr std::size_t kMinChunkBytes = 64 * 1024;
+    static constexpr std::size_t kMaxChunkBytes = 1024 * 1024;
+
+    explicit MemoryPool(std::size_t blockSize, std::size_t initialBlocks = 1024);
+    ~MemoryPool();
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    void* Allocate();
+
+    void Deallocate(void* ptr);
+
+    // 把当前线程弹匣中的块全部归还共享空闲列表
+    void FlushThreadCache();
+
+    std::size_t GetBlockSize() const { return blockSize; }
+
+    // 已从系统申请的块总数
+    std::size_t GetTotalBlocks();
+
+    // 当前分配出去的块数，不包括空闲列表和各线程弹匣中缓存的块；其他线程同时分配时为近似值
+    std::size_t GetUsedBlocks();
+
+    struct Magazine {
+        std::uint64_t poolId = 0;   // 弹匣当前属于哪个池，池销毁后槽位可能被新池复用
+        // 只由所属线程修改，统计存活块数时其他线程会读取
+        std::atomic<std::size_t> count{0};
+        void* blocks[kMagazineCapacity];
+
+        Magazine() = default;
+        // 线程缓存扩容时复制
+        Magazine(const Magazine& other);
+    };
+
+    // 线程退出时归还弹匣中的块
+    void ReturnBlocks(void* const* returned, std::size_t count);
+
+private:
+    std::size_t blockSize;
+    std::uint64_t poolId;
+    std::size_t slot;   // 在线程缓存中的下标
+
+    std::vector<void*> freeBlocks;
+    std::vector<void*> chunks;
+    std::size_t totalBlocks;
+    std::mutex mutex;
+
+
+    Magazine& GetMagazine();
+
+
+    // 本线程首次使用本池时扩容线程缓存并登记，之后才能在统计时被其他线程读取
+    Magazine& AttachMagazine();
+
+
+    void Refill(Magazine& magazine);
+
+
+    void Flush(Magazine& magazine, std::size_t count);
+
+
+    // 分配一个容纳 count 个块的 slab 并切分到空闲列表
+    void ExpandPool(std::size_t count);
+
+
+    // 下一个 slab 的块数：与现有容量相同，但不超过 kMaxChunkBytes
+    std::size_t GetNextChunkBlockCount() const;
+};
+
+} // namespace GE
+
+#endif // MEMORYPOOL_H
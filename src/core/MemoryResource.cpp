@@ -0,0 +1,59 @@
+#include "MemoryResource.h"
+#include "MemoryManager.h"
+#include "FrameArena.h"
+#include <new>
+
+namespace GE {
+
+PoolMemoryResource::PoolMemoryResource(MemoryManagerModule& memoryManager, MemoryTag tag)
+    : memoryManager(memoryManager), tag(tag) {}
+
+PoolMemoryResource& PoolMemoryResource::GetDefault(MemoryTag tag) {
+    // 有意不销毁，进程退出阶段仍然可用
+    static PoolMemoryResource* resources = []() {
+        MemoryManagerModule& memoryManager = MemoryManagerModule::GetDefault();
+        auto* result = static_cast<PoolMemoryResource*>(::operator new(sizeof(PoolMemoryResource) * kMemoryTagCount));
+        for (std::size_t index = 0; index < kMemoryTagCount; ++index) {
+            new (result + index) PoolMemoryResource(memoryManager, static_cast<MemoryTag>(index));
+        }
+        return result;
+    }();
+    return resources[static_cast<std::size_t>(tag)];
+}
+
+void* PoolMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    if (alignment > alignof(std::max_align_t)) {
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+    return memoryManager.AllocateMemory(bytes, tag);
+}
+
+void PoolMemoryResource::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) {
+    if (alignment > alignof(std::max_align_t)) {
+        ::operator delete(ptr, std::align_val_t(alignment));
+        return;
+    }
+    memoryManager.FreeMemory(ptr, bytes, tag);
+}
+
+bool PoolMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    const auto* pool = dynamic_cast<const PoolMemoryResource*>(&other);
+    return pool && &pool->memoryManager == &memoryManager && pool->tag == tag;
+}
+
+FrameMemoryResource::FrameMemoryResource(FrameMemory& frameMemory) : frameMemory(frameMemory) {}
+
+void* FrameMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    return frameMemory.Allocate(bytes, alignment);
+}
+
+void FrameMemoryResource::do_deallocate(void*, std::size_t, std::size_t) {
+    // 帧内存整体回收
+}
+
+bool FrameMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    const auto* frame = dynamic_cast<const FrameMemoryResource*>(&other);
+    return frame && &frame->frameMemory == &frameMemory;
+}
+
+} // namespace GE
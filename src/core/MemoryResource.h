@@ -0,0 +1,52 @@
+#ifndef MEMORYRESOURCE_H
+#define MEMORYRESOURCE_H
+
+#include "MemoryTracker.h"
+#include <cstddef>
+#include <memory_resource>
+
+namespace GE {
+
+class MemoryManagerModule;
+class FrameMemory;
+
+// 由 MemoryManagerModule 的大小类别池提供内存的 std::pmr::memory_resource
+// 对齐要求超过池块对齐（alignof(std::max_align_t)）的请求直接使用对齐的 operator new。
+class PoolMemoryResource : public std::pmr::memory_resource {
+public:
+    // 经由该资源的分配计入 tag 对应的子系统
+    explicit PoolMemoryResource(MemoryManagerModule& memoryManager, MemoryTag tag = MemoryTag::General);
+
+    // 基于 MemoryManagerModule::GetDefault() 的池资源，每个标签一个实例，供没有持有 MemoryManagerModule 的模块使用
+    static PoolMemoryResource& GetDefault(MemoryTag tag = MemoryTag::General);
+
+private:
+    MemoryManagerModule& memoryManager;
+    MemoryTag tag;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+// 从当前线程的帧内存分配的 std::pmr::memory_resource
+// 释放是空操作，内存在帧缓冲轮换时整体回收，只能用于生命周期不超过帧缓冲周期的容器。
+class FrameMemoryResource : public std::pmr::memory_resource {
+public:
+    explicit FrameMemoryResource(FrameMemory& frameMemory);
+
+private:
+    FrameMemory& frameMemory;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+} // namespace GE
+
+#endif // MEMORYRESOURCE_H
@@ -0,0 +1,105 @@
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <memory>
+
+namespace GE {
+
+namespace {
+    struct ThreadCountersHolder {
+        std::unique_ptr<MemoryTracker::ThreadCounters> counters;
+
+        ~ThreadCountersHolder() {
+            if (counters) {
+                MemoryTracker::Get().RetireThread(counters.get());
+            }
+        }
+    };
+
+    thread_local ThreadCountersHolder tlsCountersHolder;
+}
+
+const char* GetMemoryTagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::General:   return "General";
+        case MemoryTag::Render:    return "Render";
+        case MemoryTag::Physics:   return "Physics";
+        case MemoryTag::Audio:     return "Audio";
+        case MemoryTag::Resources: return "Resources";
+        case MemoryTag::Scripting: return "Scripting";
+        default:                   return "Unknown";
+    }
+}
+
+MemoryTracker::ThreadCounters::ThreadCounters() {
+    for (auto& counter : bytes) counter.store(0, std::memory_order_relaxed);
+    for (auto& counter : allocations) counter.store(0, std::memory_order_relaxed);
+}
+
+MemoryTracker& MemoryTracker::Get() {
+    // 有意泄漏，保证线程在进程退出阶段析构计数器时仍然可用
+    static MemoryTracker* instance = new MemoryTracker();
+    return *instance;
+}
+
+#ifdef GE_ENABLE_MEMORY_TRACKING
+void MemoryTracker::RegisterPool(MemoryTag tag, MemoryPool* pool) {
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    pools.emplace_back(tag, pool);
+}
+
+void MemoryTracker::UnregisterPool(MemoryPool* pool) {
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    pools.erase(std::remove_if(pools.begin(), pools.end(), [pool](const auto& entry) { return entry.second == pool; }), pools.end());
+}
+#endif
+
+MemoryStats MemoryTracker::Collect() {
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    MemoryStats stats;
+    for (std::size_t tag = 0; tag < kMemoryTagCount; ++tag) {
+        stats.tags[tag].bytes = retiredBytes[tag];
+        stats.tags[tag].allocationCount = retiredAllocations[tag];
+        for (const ThreadCounters* counters : threads) {
+            stats.tags[tag].bytes += counters->bytes[tag].load(std::memory_order_relaxed);
+            stats.tags[tag].allocationCount += counters->allocations[tag].load(std::memory_order_relaxed);
+        }
+    }
+    for (const auto& [tag, pool] : pools) {
+        std::int64_t usedBlocks = static_cast<std::int64_t>(pool->GetUsedBlocks());
+        MemoryTagStats& tagStats = stats.tags[static_cast<std::size_t>(tag)];
+        tagStats.bytes += usedBlocks * static_cast<std::int64_t>(pool->GetBlockSize());
+        tagStats.allocationCount += usedBlocks;
+    }
+    for (std::size_t tag = 0; tag < kMemoryTagCount; ++tag) {
+        peakBytes[tag] = std::max(peakBytes[tag], stats.tags[tag].bytes);
+        stats.tags[tag].peakBytes = peakBytes[tag];
+        stats.totalBytes += stats.tags[tag].bytes;
+    }
+    peakTotalBytes = std::max(peakTotalBytes, stats.totalBytes);
+    stats.peakTotalBytes = peakTotalBytes;
+    return stats;
+}
+
+void MemoryTracker::RetireThread(ThreadCounters* counters) {
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    for (std::size_t tag = 0; tag < kMemoryTagCount; ++tag) {
+        retiredBytes[tag] += counters->bytes[tag].load(std::memory_order_relaxed);
+        retiredAllocations[tag] += counters->allocations[tag].load(std::memory_order_relaxed);
+    }
+    threads.erase(std::remove(threads.begin(), threads.end(), counters), threads.end());
+    if (threadCounters == counters) {
+        threadCounters = nullptr;
+    }
+}
+
+MemoryTracker::ThreadCounters* MemoryTracker::RegisterThread() {
+    tlsCountersHolder.counters = std::make_unique<ThreadCounters>();
+    threadCounters = tlsCountersHolder.counters.get();
+
+    MemoryTracker& tracker = Get();
+    std::lock_guard<std::mutex> lock(tracker.trackerMutex);
+    tracker.threads.push_back(threadCounters);
+    return threadCounters;
+}
+
+} // namespace GE
@@ -0,0 +1,122 @@
+#ifndef MEMORYTRACKER_H
+#define MEMORYTRACKER_H
+
+#include "MemoryPool.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace GE {
+
+// 内存分配所属的子系统
+enum class MemoryTag : std::uint8_t { General, Render, Physics, Audio, Resources, Scripting };
+
+constexpr std::size_t kMemoryTagCount = 6;
+
+const char* GetMemoryTagName(MemoryTag tag);
+
+struct MemoryTagStats {
+    std::int64_t bytes = 0;             // 当前存活的字节数
+    std::int64_t allocationCount = 0;   // 当前存活的分配次数
+    std::int64_t peakBytes = 0;         // 只在统计时采样
+};
+
+struct MemoryStats {
+    MemoryTagStats tags[kMemoryTagCount];
+    std::int64_t totalBytes = 0;
+    std::int64_t peakTotalBytes = 0;    // 只在统计时采样
+};
+
+// 内存统计
+// 池分配不在分配路径上计数：每个标签使用自己的一组池，统计时用各池的存活块数乘以块大小。
+// 不经过池的分配由每个线程只写自己的计数器（无锁、无共享缓存行），统计时再汇总所有线程；
+// 在一个线程分配、另一个线程释放时各线程的计数可能为负，汇总结果仍然正确。
+// 峰值只在统计时采样。未定义 GE_ENABLE_MEMORY_TRACKING 时不登记池、记录函数为空，统计结果全部为零。
+class MemoryTracker {
+public:
+    static MemoryTracker& Get();
+
+#ifdef GE_ENABLE_MEMORY_TRACKING
+    // 池中的存活块计入 tag，池销毁前必须注销
+    void RegisterPool(MemoryTag tag, MemoryPool* pool);
+
+    void UnregisterPool(MemoryPool* pool);
+
+    // 只记录不经过已登记池的分配
+    static void RecordAllocation(MemoryTag tag, std::size_t size) {
+        Record(tag, static_cast<std::int64_t>(size), 1);
+    }
+
+    static void RecordFree(MemoryTag tag, std::size_t size) {
+        Record(tag, -static_cast<std::int64_t>(size), -1);
+    }
+#else
+    void RegisterPool(MemoryTag, MemoryPool*) {}
+
+    void UnregisterPool(MemoryPool*) {}
+
+    static void RecordAllocation(MemoryTag, std::size_t) {}
+
+    static void RecordFree(MemoryTag, std::size_t) {}
+#endif
+
+    // 汇总已登记池和所有线程的计数并更新峰值
+    MemoryStats Collect();
+
+    struct alignas(64) ThreadCounters {
+        std::atomic<std::int64_t> bytes[kMemoryTagCount];
+        std::atomic<std::int64_t> allocations[kMemoryTagCount];
+
+        ThreadCounters();
+    };
+
+    // 线程退出时把计数并入已退出线程的合计
+    void RetireThread(ThreadCounters* counters);
+
+private:
+    MemoryTracker() = default;
+
+    // 已登记线程的计数器
+    std::vector<ThreadCounters*> threads;
+    // 已退出线程的合计
+    std::int64_t retiredBytes[kMemoryTagCount] = {};
+    std::int64_t retiredAllocations[kMemoryTagCount] = {};
+
+    std::vector<std::pair<MemoryTag, MemoryPool*>> pools;
+
+    std::int64_t peakBytes[kMemoryTagCount] = {};
+    std::int64_t peakTotalBytes = 0;
+    mutable std::mutex trackerMutex;
+
+
+    // 快速路径只读这个常量初始化的指针，不经过线程局部对象的动态初始化检查
+    static inline thread_local ThreadCounters* threadCounters = nullptr;
+
+
+    // 只有所属线程写入，relaxed 的读后写即可，不需要带总线锁的原子加法
+    static void AddRelaxed(std::atomic<std::int64_t>& counter, std::int64_t delta) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+
+    static void Record(MemoryTag tag, std::int64_t bytes, std::int64_t count) {
+        ThreadCounters* counters = threadCounters;
+        if (!counters) {
+            counters = RegisterThread();
+        }
+        std::size_t index = static_cast<std::size_t>(tag);
+        AddRelaxed(counters->bytes[index], bytes);
+        AddRelaxed(counters->allocations[index], count);
+    }
+
+
+    // 当前线程首次记录时创建并登记计数器
+    static ThreadCounters* RegisterThread();
+};
+
+} // namespace GE
+
+#endif // MEMORYTRACKER_H
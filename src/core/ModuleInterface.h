@@ -31,6 +31,11 @@ namespace GE {
         bool active;
     };
 
+    // 任务优先级通道，调度器总是先取高优先级通道
+    enum class TaskPriority { Critical, Normal, Background };
+
+    constexpr int kTaskPriorityCount = 3;
+
     // 任务类
     class Task {
     public:
@@ -40,6 +45,16 @@ namespace GE {
 
         const std::string& GetData() const { return data_; }
         TaskType GetType() const { return type_; }
+        TaskPriority GetPriority() const { return GetDefaultPriority(type_); }
+
+        // 各任务类型的默认优先级：渲染帧属于帧关键任务，资源加载放在后台
+        static TaskPriority GetDefaultPriority(TaskType type) {
+            switch (type) {
+                case TaskType::renderFrame:  return TaskPriority::Critical;
+                case TaskType::LoadResource: return TaskPriority::Background;
+                default:                     return TaskPriority::Normal;
+            }
+        }
 
     private:
         std::string data_;
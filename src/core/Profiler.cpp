@@ -0,0 +1,255 @@
+#include "Profiler.h"
+
+#ifdef GE_ENABLE_PROFILER
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace GE {
+
+namespace {
+    // 线程自己的区域栈，运行 Fiber 时 tlsZones 指向 Fiber 的区域栈
+    thread_local Profiler::ZoneStack tlsThreadZones;
+    thread_local Profiler::ZoneStack* tlsZones = nullptr;
+
+    std::int64_t SteadyNowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void AppendEscaped(std::string& out, const char* text) {
+        for (; *text; ++text) {
+            const char c = *text;
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            } else {
+                out += c;
+            }
+        }
+    }
+
+    void AppendMicroseconds(std::string& out, double us) {
+        char text[32];
+        int length = std::snprintf(text, sizeof(text), "%.3f", us);
+        out.append(text, static_cast<std::size_t>(length));
+    }
+}
+
+Profiler::ThreadBuffer::~ThreadBuffer() {
+    for (std::size_t i = 0; i < chunkCount; ++i) {
+        delete[] chunks[i].load(std::memory_order_relaxed);
+    }
+}
+
+Profiler& Profiler::Get() {
+    // 工作线程可能在静态析构之后仍在记录，实例不释放
+    static Profiler* instance = new Profiler();
+    return *instance;
+}
+
+void Profiler::Start() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    session.fetch_add(1, std::memory_order_relaxed);
+    frameIndex.store(0, std::memory_order_relaxed);
+    for (auto& buffer : buffers) {
+        buffer->dropped.store(0, std::memory_order_relaxed);
+    }
+    startSteadyNs = SteadyNowNs();
+    startTicks = ge::Timestamp::now();
+    stopTicks = 0;
+    recording.store(true, std::memory_order_release);
+}
+
+void Profiler::Stop() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (!recording.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    stopTicks = ge::Timestamp::now();
+    stopSteadyNs = SteadyNowNs();
+}
+
+void Profiler::BeginZone(const char* name) {
+    ZoneStack& zones = tlsZones ? *tlsZones : tlsThreadZones;
+    if (zones.depth < ZoneStack::kMaxDepth) {
+        zones.names[zones.depth] = name;
+    }
+    ++zones.depth;
+    Record(EventType::Begin, name, 0);
+}
+
+void Profiler::EndZone() {
+    ZoneStack& zones = tlsZones ? *tlsZones : tlsThreadZones;
+    if (zones.depth > 0) {
+        --zones.depth;
+    }
+    Record(EventType::End, nullptr, 0);
+}
+
+void Profiler::ResumeZones(ZoneStack& zones) {
+    tlsZones = &zones;
+    const std::uint32_t depth = std::min(zones.depth, ZoneStack::kMaxDepth);
+    for (std::uint32_t i = 0; i < depth; ++i) {
+        Record(EventType::Begin, zones.names[i], 0);
+    }
+}
+
+void Profiler::SuspendZones() {
+    if (!tlsZones) {
+        return;
+    }
+    const std::uint32_t depth = std::min(tlsZones->depth, ZoneStack::kMaxDepth);
+    for (std::uint32_t i = 0; i < depth; ++i) {
+        Record(EventType::End, nullptr, 0);
+    }
+    tlsZones = nullptr;
+}
+
+void Profiler::MarkFrame() {
+    if (IsRecording()) {
+        Record(EventType::Frame, "Frame", frameIndex.fetch_add(1, std::memory_order_relaxed));
+    }
+}
+
+void Profiler::SetCurrentThreadName(const std::string& name) {
+    ThreadBuffer* buffer = tlsBuffer ? tlsBuffer : RegisterThread();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->threadName = name;
+}
+
+const char* Profiler::InternName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return internedNames.insert(name).first->c_str();
+}
+
+void Profiler::SetMaxEventsPerThread(std::size_t count) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    maxEventsPerThread = std::max<std::size_t>(count, ThreadBuffer::kChunkSize);
+}
+
+std::uint64_t Profiler::GetDroppedEventCount() const {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::uint64_t dropped = 0;
+    for (const auto& buffer : buffers) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+Profiler::ThreadBuffer* Profiler::RegisterThread() {
+    auto buffer = std::make_unique<ThreadBuffer>();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->chunkCount = (maxEventsPerThread + ThreadBuffer::kChunkSize - 1) / ThreadBuffer::kChunkSize;
+    buffer->chunks.reset(new std::atomic<Event*>[buffer->chunkCount]());
+    buffer->threadId = static_cast<std::uint32_t>(buffers.size() + 1);
+    buffer->threadName = "Thread " + std::to_string(buffer->threadId);
+    tlsBuffer = buffer.get();
+    buffers.push_back(std::move(buffer));
+    return tlsBuffer;
+}
+
+Profiler::Event* Profiler::AllocateChunk(ThreadBuffer& buffer, std::size_t chunkIndex) {
+    if (chunkIndex >= buffer.chunkCount) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    // 块在多次记录之间复用，只在首次写到该位置时分配
+    Event* chunk = new Event[ThreadBuffer::kChunkSize];
+    buffer.chunks[chunkIndex].store(chunk, std::memory_order_release);
+    return chunk;
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    const std::uint32_t currentSession = session.load(std::memory_order_relaxed);
+
+    // 用本次记录的起止时刻校准计数频率
+    const std::uint64_t endTicks = stopTicks ? stopTicks : ge::Timestamp::now();
+    const std::int64_t endSteadyNs = stopTicks ? stopSteadyNs : SteadyNowNs();
+    double ticksPerUs = ge::Timestamp::get_ticks_per_second() / 1e6;
+    if (endSteadyNs - startSteadyNs > 1000000 && endTicks > startTicks) {
+        ticksPerUs = static_cast<double>(endTicks - startTicks) * 1e3 / static_cast<double>(endSteadyNs - startSteadyNs);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "无法写入性能分析文件: " << path << std::endl;
+        return false;
+    }
+
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto beginEvent = [&]() {
+        if (!first) {
+            out += ",\n";
+        }
+        first = false;
+    };
+    auto flushOut = [&]() {
+        if (out.size() > (1 << 20)) {
+            file.write(out.data(), static_cast<std::streamsize>(out.size()));
+            out.clear();
+        }
+    };
+
+    for (const auto& buffer : buffers) {
+        const std::string tid = std::to_string(buffer->threadId);
+        beginEvent();
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":\"";
+        AppendEscaped(out, buffer->threadName.c_str());
+        out += "\"}}";
+
+        if (buffer->session.load(std::memory_order_acquire) != currentSession) {
+            continue;
+        }
+        const std::size_t count = buffer->count.load(std::memory_order_acquire);
+        double lastUs = 0.0;
+        int depth = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const Event* chunk = buffer->chunks[i / ThreadBuffer::kChunkSize].load(std::memory_order_acquire);
+            const Event& event = chunk[i % ThreadBuffer::kChunkSize];
+            lastUs = static_cast<double>(static_cast<std::int64_t>(event.ticks - startTicks)) / ticksPerUs;
+
+            // 记录开始前进入的区域没有开始事件，跳过其结束事件
+            if (event.type == EventType::End && depth == 0) {
+                continue;
+            }
+            beginEvent();
+            if (event.type == EventType::Frame) {
+                out += "{\"name\":\"Frame " + std::to_string(event.frame) + "\",\"ph\":\"i\",\"s\":\"g\",\"ts\":";
+            } else if (event.type == EventType::Begin) {
+                ++depth;
+                out += "{\"name\":\"";
+                AppendEscaped(out, event.name);
+                out += "\",\"ph\":\"B\",\"ts\":";
+            } else {
+                --depth;
+                out += "{\"ph\":\"E\",\"ts\":";
+            }
+            AppendMicroseconds(out, lastUs);
+            out += ",\"pid\":1,\"tid\":" + tid + "}";
+            flushOut();
+        }
+        for (; depth > 0; --depth) {
+            beginEvent();
+            out += "{\"ph\":\"E\",\"ts\":";
+            AppendMicroseconds(out, lastUs);
+            out += ",\"pid\":1,\"tid\":" + tid + "}";
+        }
+    }
+    out += "\n]}\n";
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+} // namespace GE
+
+#endif // GE_ENABLE_PROFILER
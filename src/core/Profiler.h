@@ -0,0 +1,174 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#ifdef GE_ENABLE_PROFILER
+
+#include <application/timestamp.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace GE {
+
+// 帧性能分析器
+// 各线程把区域的开始/结束和帧标记写入自己的事件缓冲区，写入不加锁；记录的事件导出为 Chrome trace JSON，
+// 用 chrome://tracing 或 Perfetto 离线查看。区域名必须是字符串常量或 InternName 返回的字符串。
+// Fiber 内的区域可以跨越让出和等待：Fiber 切出时结束其未结束的区域，恢复时在所在线程上重新开始。
+// 未定义 GE_ENABLE_PROFILER 时 GE_PROFILE_* 宏为空，分析器完全不参与编译。
+class Profiler {
+public:
+    static Profiler& Get();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // 开始新一次记录，上一次记录的事件被丢弃
+    void Start();
+
+    void Stop();
+
+    bool IsRecording() const { return recording.load(std::memory_order_relaxed); }
+
+    // 不内联：Fiber 可能在区域内迁移到其他线程，每次都要重新读取线程局部变量
+    void BeginZone(const char* name);
+
+    void EndZone();
+
+    void MarkFrame();
+
+    // 导出结果中当前线程的名称
+    void SetCurrentThreadName(const std::string& name);
+
+    // 返回与 name 内容相同、在进程生命周期内有效的字符串，用于运行时生成的区域名
+    const char* InternName(const std::string& name);
+
+    // 每个线程最多记录的事件数，只影响之后首次记录的线程
+    void SetMaxEventsPerThread(std::size_t count);
+
+    // 导出本次记录的事件，应在 Stop 之后调用；未结束的区域在线程最后一个事件处结束
+    bool ExportChromeTrace(const std::string& path);
+
+    // 缓冲区写满后丢弃的事件数
+    std::uint64_t GetDroppedEventCount() const;
+
+    // 一个执行上下文（线程或 Fiber）中尚未结束的区域
+    struct ZoneStack {
+        static constexpr std::uint32_t kMaxDepth = 32;
+
+        const char* names[kMaxDepth] = {};
+        std::uint32_t depth = 0;  // 可能超过 kMaxDepth，超出部分切换时不重新开始
+    };
+
+    // 切换到 Fiber 前调用：此后的区域记入 zones，并重新开始其中未结束的区域
+    void ResumeZones(ZoneStack& zones);
+
+    // Fiber 切回线程后调用：结束 Fiber 未结束的区域，恢复线程自己的区域栈
+    void SuspendZones();
+
+private:
+    enum class EventType : std::uint32_t { Begin, End, Frame };
+
+    struct Event {
+        std::uint64_t ticks;
+        const char* name;
+        EventType type;
+        std::uint32_t frame;
+    };
+
+    // 只有所属线程写入；count 以 release 发布，导出时按 session 判断是否属于本次记录
+    struct ThreadBuffer {
+        static constexpr std::size_t kChunkSize = 16384;
+
+        std::unique_ptr<std::atomic<Event*>[]> chunks;
+        std::size_t chunkCount = 0;
+        std::atomic<std::size_t> count{0};
+        std::atomic<std::uint32_t> session{0};
+        std::atomic<std::uint64_t> dropped{0};
+        std::uint32_t threadId = 0;
+        std::string threadName;
+
+        ~ThreadBuffer();
+    };
+
+    static inline thread_local ThreadBuffer* tlsBuffer = nullptr;
+
+    std::atomic<bool> recording{false};
+    std::atomic<std::uint32_t> session{0};
+    std::atomic<std::uint32_t> frameIndex{0};
+    std::size_t maxEventsPerThread = 1 << 20;
+
+    // 换算时间用的起止时刻
+    std::uint64_t startTicks = 0;
+    std::int64_t startSteadyNs = 0;
+    std::uint64_t stopTicks = 0;
+    std::int64_t stopSteadyNs = 0;
+
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::unordered_set<std::string> internedNames;
+    mutable std::mutex registryMutex;
+
+    Profiler() = default;
+
+    void Record(EventType type, const char* name, std::uint32_t frame) {
+        if (!recording.load(std::memory_order_relaxed)) {
+            return;
+        }
+        ThreadBuffer* buffer = tlsBuffer ? tlsBuffer : RegisterThread();
+        const std::uint32_t current = session.load(std::memory_order_relaxed);
+        if (buffer->session.load(std::memory_order_relaxed) != current) {
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->session.store(current, std::memory_order_release);
+        }
+
+        const std::size_t index = buffer->count.load(std::memory_order_relaxed);
+        const std::size_t chunkIndex = index / ThreadBuffer::kChunkSize;
+        Event* chunk = chunkIndex < buffer->chunkCount ? buffer->chunks[chunkIndex].load(std::memory_order_relaxed) : nullptr;
+        if (!chunk && !(chunk = AllocateChunk(*buffer, chunkIndex))) {
+            return;
+        }
+        chunk[index % ThreadBuffer::kChunkSize] = { ge::Timestamp::now(), name, type, frame };
+        buffer->count.store(index + 1, std::memory_order_release);
+    }
+
+    ThreadBuffer* RegisterThread();
+
+    // 缓冲区已满时计入丢弃数并返回 nullptr
+    Event* AllocateChunk(ThreadBuffer& buffer, std::size_t chunkIndex);
+};
+
+// 作用域区域，构造时开始、析构时结束
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) { Profiler::Get().BeginZone(name); }
+
+    ~ProfileScope() { Profiler::Get().EndZone(); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+} // namespace GE
+
+#define GE_PROFILE_CONCAT_INNER(a, b) a##b
+#define GE_PROFILE_CONCAT(a, b) GE_PROFILE_CONCAT_INNER(a, b)
+
+#define GE_PROFILE_ZONE(name) ::GE::ProfileScope GE_PROFILE_CONCAT(geProfileZone, __LINE__)(name)
+#define GE_PROFILE_FUNCTION() GE_PROFILE_ZONE(__func__)
+#define GE_PROFILE_FRAME() ::GE::Profiler::Get().MarkFrame()
+#define GE_PROFILE_THREAD(name) ::GE::Profiler::Get().SetCurrentThreadName(name)
+
+#else
+
+#define GE_PROFILE_ZONE(name) ((void)0)
+#define GE_PROFILE_FUNCTION() ((void)0)
+#define GE_PROFILE_FRAME() ((void)0)
+#define GE_PROFILE_THREAD(name) ((void)0)
+
+#endif // GE_ENABLE_PROFILER
+
+#endif // PROFILER_H
@@ -0,0 +1,156 @@
+#include "ResourceCache.h"
+#include "MemoryResource.h"
+#include <algorithm>
+#include <functional>
+
+namespace GE {
+
+ResourceCache::ResourceCache(std::size_t budgetBytes, unsigned int shardCount) {
+    shardCount = std::max(shardCount, 1u);
+    shards.reserve(shardCount);
+    for (unsigned int i = 0; i < shardCount; ++i) {
+        shards.push_back(std::make_unique<Shard>(&PoolMemoryResource::GetDefault(MemoryTag::Resources)));
+    }
+    SetBudget(budgetBytes);
+}
+
+ResourceCache::Resource ResourceCache::Find(const std::string& key) {
+    Shard& shard = GetShard(key);
+    std::pmr::string lookupKey(key, shard.index.get_allocator());
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(lookupKey);
+    if (it == shard.index.end()) {
+        ++shard.misses;
+        return nullptr;
+    }
+    ++shard.hits;
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    return it->second->resource;
+}
+
+void ResourceCache::Insert(const std::string& key, Resource resource) {
+    if (!resource) {
+        return;
+    }
+    Shard& shard = GetShard(key);
+    std::pmr::string entryKey(key, shard.index.get_allocator());
+    std::size_t bytes = resource->size();
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(entryKey);
+    if (it != shard.index.end()) {
+        Entry& entry = *it->second;
+        shard.bytes -= entry.bytes;
+        entry.resource = std::move(resource);
+        entry.bytes = bytes;
+        shard.bytes += bytes;
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    } else if (bytes > shard.budgetBytes) {
+        // 单个资源超过分片预算，缓存它会挤掉整个分片
+        ++shard.rejections;
+        return;
+    } else {
+        auto inserted = shard.index.emplace(std::move(entryKey), shard.entries.end()).first;
+        shard.entries.push_front(Entry{ &inserted->first, std::move(resource), bytes, 0 });
+        inserted->second = shard.entries.begin();
+        shard.bytes += bytes;
+    }
+    EvictToBudget(shard);
+}
+
+bool ResourceCache::Erase(const std::string& key) {
+    Shard& shard = GetShard(key);
+    std::pmr::string lookupKey(key, shard.index.get_allocator());
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(lookupKey);
+    if (it == shard.index.end()) {
+        return false;
+    }
+    shard.bytes -= it->second->bytes;
+    shard.entries.erase(it->second);
+    shard.index.erase(it);
+    return true;
+}
+
+void ResourceCache::Clear() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->entries.clear();
+        shard->bytes = 0;
+    }
+}
+
+bool ResourceCache::Pin(const std::string& key) {
+    Shard& shard = GetShard(key);
+    std::pmr::string lookupKey(key, shard.index.get_allocator());
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(lookupKey);
+    if (it == shard.index.end()) {
+        return false;
+    }
+    ++it->second->pinCount;
+    return true;
+}
+
+bool ResourceCache::Unpin(const std::string& key) {
+    Shard& shard = GetShard(key);
+    std::pmr::string lookupKey(key, shard.index.get_allocator());
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(lookupKey);
+    if (it == shard.index.end() || it->second->pinCount == 0) {
+        return false;
+    }
+    if (--it->second->pinCount == 0) {
+        EvictToBudget(shard);
+    }
+    return true;
+}
+
+void ResourceCache::SetBudget(std::size_t budgetBytes) {
+    std::size_t shardBudget = budgetBytes / shards.size();
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->budgetBytes = shardBudget;
+        EvictToBudget(*shard);
+    }
+}
+
+ResourceCacheStats ResourceCache::GetStats() const {
+    ResourceCacheStats stats;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        stats.hits += shard->hits;
+        stats.misses += shard->misses;
+        stats.evictions += shard->evictions;
+        stats.rejections += shard->rejections;
+        stats.entryCount += shard->index.size();
+        stats.bytes += shard->bytes;
+        stats.budgetBytes += shard->budgetBytes;
+    }
+    return stats;
+}
+
+ResourceCache::Shard& ResourceCache::GetShard(const std::string& key) {
+    return *shards[std::hash<std::string>()(key) % shards.size()];
+}
+
+void ResourceCache::EvictToBudget(Shard& shard) {
+    // 从最久未使用的条目开始，跳过固定和仍在使用的条目；链表头部是刚插入或刚命中的条目，不淘汰
+    auto it = shard.entries.end();
+    while (shard.bytes > shard.budgetBytes && it != shard.entries.begin()) {
+        --it;
+        if (it == shard.entries.begin()) {
+            break;
+        }
+        if (it->pinCount > 0 || it->resource.use_count() > 1) {
+            continue;
+        }
+        shard.bytes -= it->bytes;
+        shard.index.erase(shard.index.find(*it->key));
+        it = shard.entries.erase(it);
+        ++shard.evictions;
+    }
+}
+
+} // namespace GE
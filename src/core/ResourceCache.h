@@ -0,0 +1,91 @@
+#ifndef RESOURCECACHE_H
+#define RESOURCECACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace GE {
+
+struct ResourceCacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::uint64_t rejections = 0;  // 超过单个分片预算而未缓存的资源
+    std::size_t entryCount = 0;
+    std::size_t bytes = 0;
+    std::size_t budgetBytes = 0;
+};
+
+// 按字节预算淘汰的资源缓存
+// 键按哈希分到多个分片，每个分片有自己的锁、LRU 链表和预算，不同分片的查找互不阻塞。
+// 仍被缓存以外引用的资源（use_count > 1）和显式 Pin 的资源不会被淘汰，淘汰它们也不能释放内存。
+class ResourceCache {
+public:
+    using Resource = std::shared_ptr<std::vector<char>>;
+
+    explicit ResourceCache(std::size_t budgetBytes, unsigned int shardCount = 16);
+
+    ResourceCache(const ResourceCache&) = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    // 命中时把条目移到 LRU 链表头部
+    Resource Find(const std::string& key);
+
+    // 插入或替换条目，超出分片预算时从链表尾部淘汰
+    void Insert(const std::string& key, Resource resource);
+
+    bool Erase(const std::string& key);
+
+    void Clear();
+
+    // 固定条目使其不被淘汰，可以嵌套；条目不存在时返回 false
+    bool Pin(const std::string& key);
+
+    bool Unpin(const std::string& key);
+
+    // 调整预算，缩小时立即淘汰
+    void SetBudget(std::size_t budgetBytes);
+
+    ResourceCacheStats GetStats() const;
+
+private:
+    struct Entry {
+        const std::pmr::string* key = nullptr;  // 指向索引节点中的键
+        Resource resource;
+        std::size_t bytes = 0;
+        unsigned int pinCount = 0;
+    };
+
+    struct alignas(64) Shard {
+        explicit Shard(std::pmr::memory_resource* memory) : entries(memory), index(memory) {}
+
+        mutable std::mutex mutex;
+        // 头部最近使用
+        std::pmr::list<Entry> entries;
+        std::pmr::unordered_map<std::pmr::string, std::pmr::list<Entry>::iterator> index;
+        std::size_t bytes = 0;
+        std::size_t budgetBytes = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        std::uint64_t rejections = 0;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    Shard& GetShard(const std::string& key);
+
+    // 在持有分片锁时调用
+    static void EvictToBudget(Shard& shard);
+};
+
+} // namespace GE
+
+#endif // RESOURCECACHE_H
@@ -0,0 +1,87 @@
+#include "Settings.h"
+#include <iostream>
+
+namespace GE {
+
+Settings& Settings::Get() {
+    static Settings instance;
+    static std::once_flag loaded;
+    std::call_once(loaded, []() {
+        instance.Load(std::string(RESOURCE_PATH) + "/settings.yaml");
+    });
+    return instance;
+}
+
+bool Settings::Load(const std::string& filePath) {
+    try {
+        YAML::Node loaded = YAML::LoadFile(filePath);
+        std::lock_guard<std::mutex> lock(settingsMutex);
+        root.reset(loaded);
+        return true;
+    } catch (const YAML::Exception& e) {
+        std::cerr << "加载配置文件失败: " << filePath << " " << e.what() << std::endl;
+        return false;
+    }
+}
+
+int Settings::GetInt(const std::string& key, int defaultValue) const {
+    return GetValue<int>(key, defaultValue);
+}
+
+double Settings::GetDouble(const std::string& key, double defaultValue) const {
+    return GetValue<double>(key, defaultValue);
+}
+
+bool Settings::GetBool(const std::string& key, bool defaultValue) const {
+    return GetValue<bool>(key, defaultValue);
+}
+
+std::string Settings::GetString(const std::string& key, const std::string& defaultValue) const {
+    return GetValue<std::string>(key, defaultValue);
+}
+
+std::vector<std::string> Settings::GetStringList(const std::string& key) const {
+    return GetValue<std::vector<std::string>>(key, {});
+}
+
+bool Settings::Find(const std::string& key, YAML::Node& result) const {
+    // 只通过 const 引用访问，避免 operator[] 向树中插入空节点
+    YAML::Node current;
+    current.reset(root);
+    std::size_t start = 0;
+    while (true) {
+        std::size_t end = key.find('.', start);
+        const YAML::Node& parent = current;
+        if (!parent.IsMap()) {
+            return false;
+        }
+        YAML::Node child = parent[key.substr(start, end == std::string::npos ? std::string::npos : end - start)];
+        if (!child.IsDefined() || child.IsNull()) {
+            return false;
+        }
+        current.reset(child);
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    result.reset(current);
+    return true;
+}
+
+template<typename T>
+T Settings::GetValue(const std::string& key, const T& defaultValue) const {
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    YAML::Node node;
+    if (!Find(key, node)) {
+        return defaultValue;
+    }
+    try {
+        return node.as<T>();
+    } catch (const YAML::Exception&) {
+        std::cerr << "配置项类型错误: " << key << std::endl;
+        return defaultValue;
+    }
+}
+
+} // namespace GE
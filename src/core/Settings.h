@@ -0,0 +1,43 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <yaml-cpp/yaml.h>
+
+namespace GE {
+
+// 引擎配置（resources/settings.yaml）的只读访问
+// 键使用点号分隔的路径，例如 "performance.max_threads"；缺失或类型不符时返回默认值。
+class Settings {
+public:
+    // 全局配置，首次调用时从 RESOURCE_PATH/settings.yaml 加载
+    static Settings& Get();
+
+    // 重新加载配置文件，失败时保留原有内容
+    bool Load(const std::string& filePath);
+
+    int GetInt(const std::string& key, int defaultValue) const;
+    double GetDouble(const std::string& key, double defaultValue) const;
+    bool GetBool(const std::string& key, bool defaultValue) const;
+    std::string GetString(const std::string& key, const std::string& defaultValue) const;
+    std::vector<std::string> GetStringList(const std::string& key) const;
+
+private:
+    Settings() = default;
+
+    YAML::Node root;
+    mutable std::mutex settingsMutex;
+
+
+    bool Find(const std::string& key, YAML::Node& result) const;
+
+
+    template<typename T>
+    T GetValue(const std::string& key, const T& defaultValue) const;
+};
+
+} // namespace GE
+
+#endif // SETTINGS_H
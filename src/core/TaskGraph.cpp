@@ -0,0 +1,142 @@
+#include "TaskGraph.h"
+#include "Profiler.h"
+#include <stdexcept>
+
+namespace GE {
+
+TaskGraph::~TaskGraph() {
+    if (activeScheduler) {
+        Wait();
+    }
+}
+
+TaskGraph::NodeId TaskGraph::AddTask(const std::string& name, std::function<void()> func, TaskPriority priority) {
+    auto node = std::make_unique<Node>();
+    node->name = name;
+#ifdef GE_ENABLE_PROFILER
+    node->profileName = Profiler::Get().InternName(name);
+#endif
+    node->func = std::move(func);
+    node->priority = priority;
+    nodes.push_back(std::move(node));
+    dirty = true;
+    return nodes.size() - 1;
+}
+
+void TaskGraph::Precede(NodeId before, NodeId after) {
+    if (before >= nodes.size() || after >= nodes.size()) {
+        throw std::out_of_range("任务图节点不存在");
+    }
+    nodes[before]->successors.push_back(after);
+    nodes[after]->predecessorCount++;
+    dirty = true;
+}
+
+void TaskGraph::Clear() {
+    if (activeScheduler) {
+        Wait();
+    }
+    nodes.clear();
+    roots.clear();
+    dirty = true;
+}
+
+std::size_t TaskGraph::GetTaskCount() const {
+    return nodes.size();
+}
+
+const std::string& TaskGraph::GetTaskName(NodeId node) const {
+    return nodes.at(node)->name;
+}
+
+void TaskGraph::Run(TaskSchedulerModule& scheduler) {
+    Dispatch(scheduler);
+    Wait();
+}
+
+void TaskGraph::Dispatch(TaskSchedulerModule& scheduler) {
+    if (activeScheduler && !completion.IsDone()) {
+        throw std::runtime_error("任务图仍在运行，无法重复提交");
+    }
+    if (dirty) {
+        Compile();
+    }
+    if (nodes.empty()) {
+        return;
+    }
+
+    for (auto& node : nodes) {
+        node->pendingPredecessors.store(node->predecessorCount, std::memory_order_relaxed);
+    }
+    activeScheduler = &scheduler;
+
+    // 提交根节点期间持有一个额外计数，防止计数器在中途短暂归零
+    completion.Add(1);
+    for (NodeId root : roots) {
+        TaskOptions options;
+        options.priority = nodes[root]->priority;
+        scheduler.SubmitTask([this, root]() { RunNode(root); }, &completion, options);
+    }
+    scheduler.SignalCounter(completion);
+}
+
+void TaskGraph::Wait() {
+    if (!activeScheduler) {
+        return;
+    }
+    activeScheduler->WaitForCounter(completion);
+    activeScheduler = nullptr;
+}
+
+TaskCounter& TaskGraph::GetCompletionCounter() {
+    return completion;
+}
+
+void TaskGraph::Compile() {
+    roots.clear();
+    std::vector<int> inDegree(nodes.size());
+    std::vector<NodeId> ready;
+    for (NodeId i = 0; i < nodes.size(); ++i) {
+        inDegree[i] = nodes[i]->predecessorCount;
+        if (inDegree[i] == 0) {
+            roots.push_back(i);
+            ready.push_back(i);
+        }
+    }
+
+    std::size_t visited = 0;
+    while (!ready.empty()) {
+        NodeId current = ready.back();
+        ready.pop_back();
+        ++visited;
+        for (NodeId next : nodes[current]->successors) {
+            if (--inDegree[next] == 0) {
+                ready.push_back(next);
+            }
+        }
+    }
+
+    if (visited != nodes.size()) {
+        throw std::runtime_error("任务图存在循环依赖");
+    }
+    dirty = false;
+}
+
+void TaskGraph::RunNode(NodeId node) {
+    Node& current = *nodes[node];
+    if (current.func) {
+        GE_PROFILE_ZONE(current.profileName);
+        current.func();
+    }
+
+    // 先提交后继再让本节点完成计数，保证完成计数器不会提前归零
+    for (NodeId next : current.successors) {
+        if (nodes[next]->pendingPredecessors.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            TaskOptions options;
+            options.priority = nodes[next]->priority;
+            activeScheduler->SubmitTask([this, next]() { RunNode(next); }, &completion, options);
+        }
+    }
+}
+
+} // namespace GE
@@ -0,0 +1,81 @@
+#ifndef TASKGRAPH_H
+#define TASKGRAPH_H
+
+#include "TaskScheduler.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GE {
+
+// 任务依赖图
+// 构建一次后可每帧重复运行：Run 只重置各节点的前驱计数，不会重新分配节点。
+// 节点在所有前驱完成后自动进入调度器队列。
+class TaskGraph {
+public:
+    using NodeId = std::size_t;
+
+    TaskGraph() = default;
+    ~TaskGraph();
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    // 添加任务节点
+    NodeId AddTask(const std::string& name, std::function<void()> func, TaskPriority priority = TaskPriority::Normal);
+
+    // before 完成后才运行 after
+    void Precede(NodeId before, NodeId after);
+
+    // 清空所有节点
+    void Clear();
+
+    std::size_t GetTaskCount() const;
+
+    const std::string& GetTaskName(NodeId node) const;
+
+    // 提交并等待全部节点完成，调用线程在等待期间协助执行任务
+    void Run(TaskSchedulerModule& scheduler);
+
+    // 仅提交，不等待
+    void Dispatch(TaskSchedulerModule& scheduler);
+
+    // 等待上一次 Dispatch 完成
+    void Wait();
+
+    // 上一次提交的所有节点完成后归零，可用于 SubmitTaskAfter
+    TaskCounter& GetCompletionCounter();
+
+private:
+    struct Node {
+        std::string name;
+#ifdef GE_ENABLE_PROFILER
+        const char* profileName = nullptr;
+#endif
+        std::function<void()> func;
+        TaskPriority priority = TaskPriority::Normal;
+        std::vector<NodeId> successors;
+        int predecessorCount = 0;
+        std::atomic<int> pendingPredecessors{0};
+    };
+
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::vector<NodeId> roots;
+    bool dirty = true;
+
+    TaskCounter completion;
+    TaskSchedulerModule* activeScheduler = nullptr;
+
+
+    // 计算根节点并检查循环依赖
+    void Compile();
+
+
+    void RunNode(NodeId node);
+};
+
+} // namespace GE
+
+#endif // TASKGRAPH_H
@@ -1,12 +1,6 @@
-#include "ModuleInterface.h"
-#include <queue>
-#include <mutex>
-#include <condition_variable>
-#include <thread>
-#include <vector>
-#include <functional>
-#include <future>
-#include <atomic>
+#include "TaskScheduler.h"
+#include "Profiler.h"
+#include "ThreadTopology.h"
 #include <iostream>
 #include <nlohmann/json.hpp> // 使用数据格式（JSON）
 
@@ -14,119 +8,461 @@ namespace GE {
 
 using json = nlohmann::json;
 
-class TaskSchedulerModule : public ModuleInterface {
-public:
-    TaskSchedulerModule() : stop(false) {}
+namespace {
+    // 当前线程所属的调度器及工作线程索引
+    thread_local TaskSchedulerModule* tlsScheduler = nullptr;
+    thread_local int tlsWorkerIndex = -1;
 
-    void initialize() override {
-        unsigned int threadCount = std::thread::hardware_concurrency();
-        if (threadCount == 0) threadCount = 4; // 默认使用 4 个线程
-        for (unsigned int i = 0; i < threadCount; ++i) {
-            workers.emplace_back(&TaskSchedulerModule::WorkerThreadFunc, this);
+    // 当前线程在某个调度器中使用的任务池；用 id 而非指针区分调度器，避免地址复用
+    thread_local std::uint64_t tlsPoolSchedulerId = 0;
+    thread_local TaskItemPool* tlsPool = nullptr;
+
+    std::atomic<std::uint64_t> nextSchedulerId{1};
+
+    // 窃取时随机选择起始目标，避免所有空闲线程扎堆同一个队列
+    std::size_t NextVictimSeed() {
+        thread_local std::uint32_t state = static_cast<std::uint32_t>(
+            std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    constexpr int kSpinCount = 64;
+
+    std::int64_t SteadyNowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    constexpr std::int64_t kNoDeadline = INT64_MAX;
+}
+
+TaskItem* TaskItemPool::Allocate() {
+    if (!localFree) {
+        localFree = remoteFree.exchange(nullptr, std::memory_order_acquire);
+    }
+    if (!localFree) {
+        // 仅在预热阶段发生，稳态下任务项都来自回收链表
+        auto block = std::make_unique<TaskItem[]>(kBlockSize);
+        for (std::size_t i = 0; i < kBlockSize; ++i) {
+            block[i].owner = this;
+            block[i].next = localFree;
+            localFree = &block[i];
+        }
+        blocks.push_back(std::move(block));
+    }
+    TaskItem* item = localFree;
+    localFree = item->next;
+    item->next = nullptr;
+    return item;
+}
+
+void TaskItemPool::FreeLocal(TaskItem* item) {
+    item->next = localFree;
+    localFree = item;
+}
+
+void TaskItemPool::FreeRemote(TaskItem* item) {
+    TaskItem* head = remoteFree.load(std::memory_order_relaxed);
+    do {
+        item->next = head;
+    } while (!remoteFree.compare_exchange_weak(head, item, std::memory_order_release, std::memory_order_relaxed));
+}
+
+TaskSchedulerModule::TaskSchedulerModule()
+    : schedulerId(nextSchedulerId.fetch_add(1, std::memory_order_relaxed)),
+      readyWorkers(0), injectHead{}, injectTail{}, injectCount{},
+      frameBudgetNs(0), backgroundBudgetNs(0), frameDeadlineNs(kNoDeadline), backgroundTimeNs(0), missedDeadlines(0),
+      sleepingWorkers(0), stop(false) {}
+
+TaskSchedulerModule::~TaskSchedulerModule() {
+    if (!workerThreads.empty()) {
+        shutdown();
+    }
+}
+
+void TaskSchedulerModule::initialize() {
+    // 线程数由拓扑服务统一分配，不再各自占满 hardware_concurrency
+    unsigned int threadCount = ThreadTopology::Get().GetThreadCount(ThreadPoolType::Compute);
+    stop = false;
+    readyWorkers = 0;
+
+    workers.resize(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        workerThreads.emplace_back(&TaskSchedulerModule::WorkerThreadFunc, this, i);
+    }
+    // 所有队列创建完成后才返回，之后 workers 不再变化
+    while (readyWorkers.load(std::memory_order_acquire) < threadCount) {
+        std::this_thread::yield();
+    }
+    std::cout << "任务调度器初始化 " << threadCount << " threads." << std::endl;
+}
+
+void TaskSchedulerModule::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stop = true;
+    }
+    cv.notify_all();
+    for (auto& thread : workerThreads) {
+        if (thread.joinable()) {
+            thread.join();
         }
-        std::cout << "任务调度器初始化 " << threadCount << " threads." << std::endl;
     }
+    workerThreads.clear();
+    workers.clear();
+    std::cout << "TaskScheduler 已关闭。" << std::endl;
+}
+
+void TaskSchedulerModule::onEvent(const std::string& event) {
+    std::cout << "Received event: " << event << std::endl;
+    if (event == "shutdown") {
+        StopScheduler();
+    }
+}
+
+void TaskSchedulerModule::processTask(const Task& task) {
+    auto parsedTask = ParseTaskData(task.GetData());
+    TaskOptions options;
+    options.priority = task.GetPriority();
+    SubmitTask([parsedTask]() {
+        std::cout << "正在执行解析任务: " << parsedTask << std::endl;
+    }, nullptr, options);
+}
+
+void TaskSchedulerModule::update() {
+    std::cout << "TaskSchedulerModule updated." << std::endl;
+}
+
+unsigned int TaskSchedulerModule::GetWorkerCount() const {
+    return static_cast<unsigned int>(workers.size());
+}
 
-    void shutdown() override {
+int TaskSchedulerModule::GetCurrentWorkerIndex() const {
+    return tlsScheduler == this ? tlsWorkerIndex : -1;
+}
+
+void TaskSchedulerModule::SetFrameBudget(std::chrono::nanoseconds frameBudget, std::chrono::nanoseconds backgroundBudget) {
+    frameBudgetNs.store(frameBudget.count(), std::memory_order_relaxed);
+    backgroundBudgetNs.store(backgroundBudget.count(), std::memory_order_relaxed);
+}
+
+void TaskSchedulerModule::BeginFrame() {
+    const std::int64_t budget = frameBudgetNs.load(std::memory_order_relaxed);
+    frameDeadlineNs.store(budget > 0 ? SteadyNowNs() + budget : kNoDeadline, std::memory_order_relaxed);
+    backgroundTimeNs.store(0, std::memory_order_relaxed);
+
+    // 上一帧被节流的后台任务重新可领取
+    if (HasPendingTask()) {
         {
             std::lock_guard<std::mutex> lock(queueMutex);
-            stop = true;
         }
         cv.notify_all();
-        for (auto& worker : workers) {
-            if (worker.joinable()) {
-                worker.join();
-            }
+    }
+}
+
+std::uint64_t TaskSchedulerModule::GetMissedDeadlineCount() const {
+    return missedDeadlines.load(std::memory_order_relaxed);
+}
+
+TaskItem* TaskSchedulerModule::AllocateTask(const TaskOptions& options) {
+    TaskItem* task = GetCurrentPool()->Allocate();
+    task->priority = options.priority;
+    task->deadline = kNoDeadline;
+    if (options.deadline != std::chrono::steady_clock::time_point::max()) {
+        task->deadline = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            options.deadline.time_since_epoch()).count();
+        // 截止时间落在当前帧内，视为帧关键任务
+        if (task->deadline <= frameDeadlineNs.load(std::memory_order_relaxed)) {
+            task->priority = TaskPriority::Critical;
+        }
+    }
+    return task;
+}
+
+TaskItemPool* TaskSchedulerModule::GetCurrentPool() {
+    if (tlsPoolSchedulerId == schedulerId) {
+        return tlsPool;
+    }
+
+    TaskItemPool* pool = nullptr;
+    int index = GetCurrentWorkerIndex();
+    if (index >= 0) {
+        pool = &workers[index]->pool;
+    } else {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        externalPools.push_back(std::make_unique<TaskItemPool>());
+        pool = externalPools.back().get();
+    }
+    tlsPoolSchedulerId = schedulerId;
+    tlsPool = pool;
+    return pool;
+}
+
+void TaskSchedulerModule::ReleaseTask(TaskItem* task) {
+    task->func.Reset();
+    task->counter = nullptr;
+    if (tlsPoolSchedulerId == schedulerId && tlsPool == task->owner) {
+        task->owner->FreeLocal(task);
+    } else {
+        task->owner->FreeRemote(task);
+    }
+}
+
+void TaskSchedulerModule::DeferTask(TaskCounter& dependency, TaskItem* task) {
+    {
+        // 与 SignalCounter 在同一把锁下检查，避免依赖恰好归零时丢失后续任务
+        std::lock_guard<std::mutex> lock(dependency.continuationMutex);
+        if (!dependency.IsDone()) {
+            task->next = dependency.continuations;
+            dependency.continuations = task;
+            return;
         }
-        std::cout << "TaskScheduler 已关闭。" << std::endl;
     }
+    PushTask(task);
+}
 
-    void onEvent(const std::string& event) override {
-        std::cout << "Received event: " << event << std::endl;
-        if (event == "shutdown") {
-            StopScheduler();
+void TaskSchedulerModule::WaitForCounter(TaskCounter& counter) {
+    const int index = GetCurrentWorkerIndex();
+    while (!counter.IsDone()) {
+        TaskItem* task = FindTask(index, true);
+        if (task) {
+            RunTask(task);
+        } else {
+            std::this_thread::yield();
         }
     }
+    std::lock_guard<std::mutex> lock(counter.continuationMutex);
+}
 
-    void processTask(const Task& task) override {
-        auto parsedTask = ParseTaskData(task.GetData());
-        EnqueueTask([parsedTask]() {
-            std::cout << "正在执行解析任务: " << parsedTask << std::endl;
-        });
+void TaskSchedulerModule::PushTask(TaskItem* task) {
+    const int lane = static_cast<int>(task->priority);
+    int index = GetCurrentWorkerIndex();
+    if (index >= 0) {
+        // 工作线程产生的任务进入本地队列，无需加锁
+        workers[index]->deques[lane].Push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        task->next = nullptr;
+        if (injectTail[lane]) {
+            injectTail[lane]->next = task;
+        } else {
+            injectHead[lane] = task;
+        }
+        injectTail[lane] = task;
+        injectCount[lane].fetch_add(1, std::memory_order_relaxed);
     }
 
-    void update() override {
-        std::cout << "TaskSchedulerModule updated." << std::endl;
+    // 与 WorkerThreadFunc 中的休眠计数配对，保证不会丢失唤醒
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepingWorkers.load(std::memory_order_relaxed) > 0) {
+        WakeWorker();
     }
+}
 
-    template<typename Func, typename... Args>
-    auto ScheduleTask(Func&& func, Args&&... args) -> std::future<typename std::result_of<Func(Args...)>::type> {
-        using return_type = typename std::result_of<Func(Args...)>::type;
+void TaskSchedulerModule::RunTask(TaskItem* task) {
+    GE_PROFILE_ZONE("Task");
+    if (task->deadline != kNoDeadline && SteadyNowNs() > task->deadline) {
+        missedDeadlines.fetch_add(1, std::memory_order_relaxed);
+    }
 
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<Func>(func), std::forward<Args>(args)...)
-        );
+    if (task->priority == TaskPriority::Background) {
+        const std::int64_t start = SteadyNowNs();
+        task->func();
+        backgroundTimeNs.fetch_add(SteadyNowNs() - start, std::memory_order_relaxed);
+    } else {
+        task->func();
+    }
+    TaskCounter* counter = task->counter;
+    ReleaseTask(task);
+    if (counter) {
+        SignalCounter(*counter);
+    }
+}
 
-        std::future<return_type> res = task->get_future();
-        {
-            std::lock_guard<std::mutex> lock(queueMutex);
-            tasks.emplace([task]() { (*task)(); });
+void TaskSchedulerModule::SignalCounter(TaskCounter& counter) {
+    int current = counter.value.load(std::memory_order_relaxed);
+    while (current > 1) {
+        if (counter.value.compare_exchange_weak(current, current - 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return;
         }
-        cv.notify_one();
-        return res;
     }
 
-private:
-    std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
-    std::mutex queueMutex;
-    std::condition_variable cv;
-    std::atomic<bool> stop;
+    // 归零只在锁内发生，WaitForCounter 返回前会再取一次锁，计数器可以在返回后立即销毁
+    std::lock_guard<std::mutex> lock(counter.continuationMutex);
+    counter.value.fetch_sub(1, std::memory_order_acq_rel);
+    TaskItem* continuation = counter.continuations;
+    counter.continuations = nullptr;
+    while (continuation) {
+        TaskItem* next = continuation->next;
+        PushTask(continuation);
+        continuation = next;
+    }
+}
 
-    void EnqueueTask(std::function<void()> func) {
-        {
-            std::lock_guard<std::mutex> lock(queueMutex);
-            tasks.emplace(func);
+void TaskSchedulerModule::WorkerThreadFunc(unsigned int index) {
+    ThreadTopology::Get().PinCurrentThread(ThreadPoolType::Compute, index);
+    ThreadTopology::SetCurrentThreadName("GE Worker " + std::to_string(index));
+
+    workers[index] = std::make_unique<Worker>();
+    const unsigned int workerCount = static_cast<unsigned int>(workers.size());
+    readyWorkers.fetch_add(1, std::memory_order_acq_rel);
+    while (readyWorkers.load(std::memory_order_acquire) < workerCount) {
+        std::this_thread::yield();
+    }
+
+    tlsScheduler = this;
+    tlsWorkerIndex = static_cast<int>(index);
+
+    while (true) {
+        // 关闭时忽略后台预算，保证队列排空
+        const bool draining = stop.load(std::memory_order_relaxed);
+        TaskItem* task = FindTask(static_cast<int>(index), draining);
+        for (int spin = 0; !task && spin < kSpinCount; ++spin) {
+            std::this_thread::yield();
+            task = FindTask(static_cast<int>(index), draining);
+        }
+
+        if (task) {
+            RunTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(queueMutex);
+        sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        cv.wait(lock, [this]() { return stop.load() || HasPendingTask(); });
+        sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+        if (stop.load() && !HasPendingTask(true)) {
+            break;
         }
-        cv.notify_one();
     }
 
-    void WorkerThreadFunc() {
-        while (true) {
-            std::function<void()> taskFunc;
-            {
-                std::unique_lock<std::mutex> lock(queueMutex);
-                cv.wait(lock, [this]() { return stop.load() || !tasks.empty(); });
-                if (stop.load() && tasks.empty()) {
-                    break;
-                }
-                if (!tasks.empty()) {
-                    taskFunc = std::move(tasks.front());
-                    tasks.pop();
+    tlsScheduler = nullptr;
+    tlsWorkerIndex = -1;
+}
+
+TaskItem* TaskSchedulerModule::FindTask(int index, bool allowThrottled) {
+    const std::size_t count = workers.size();
+    const std::size_t start = count > 0 ? NextVictimSeed() % count : 0;
+
+    TaskItem* task = nullptr;
+    for (int lane = 0; lane < kTaskPriorityCount; ++lane) {
+        if (lane == static_cast<int>(TaskPriority::Background) && !allowThrottled && IsBackgroundThrottled()) {
+            break;
+        }
+
+        if (index >= 0 && workers[index]->deques[lane].Pop(task)) {
+            return task;
+        }
+
+        if (injectCount[lane].load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (injectHead[lane]) {
+                task = injectHead[lane];
+                injectHead[lane] = task->next;
+                if (!injectHead[lane]) {
+                    injectTail[lane] = nullptr;
                 }
+                task->next = nullptr;
+                injectCount[lane].fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t victim = (start + i) % count;
+            if (static_cast<int>(victim) == index) {
+                continue;
             }
-            if (taskFunc) {
-                taskFunc();
+            if (workers[victim]->deques[lane].Steal(task)) {
+                return task;
+            }
+        }
+    }
+    return nullptr;
+}
+
+bool TaskSchedulerModule::HasPendingTask(bool includeThrottled) const {
+    for (int lane = 0; lane < kTaskPriorityCount; ++lane) {
+        if (lane == static_cast<int>(TaskPriority::Background) && !includeThrottled && IsBackgroundThrottled()) {
+            break;
+        }
+        if (injectCount[lane].load(std::memory_order_relaxed) > 0) {
+            return true;
+        }
+        for (const auto& worker : workers) {
+            if (!worker->deques[lane].Empty()) {
+                return true;
             }
         }
     }
+    return false;
+}
+
+bool TaskSchedulerModule::IsBackgroundThrottled() const {
+    const std::int64_t budget = backgroundBudgetNs.load(std::memory_order_relaxed);
+    return budget > 0 && backgroundTimeNs.load(std::memory_order_relaxed) >= budget;
+}
+
+void TaskSchedulerModule::WakeWorker() {
+    {
+        // 持锁保证休眠线程要么尚未检查条件，要么已进入等待
+        std::lock_guard<std::mutex> lock(queueMutex);
+    }
+    cv.notify_one();
+}
+
+std::string TaskSchedulerModule::ParseTaskData(const std::string& data) {
+    try {
+        json parsedData = json::parse(data);
+        std::string taskType = parsedData["task_type"];
+        return taskType;
+    } catch (const json::parse_error& e) {
+        std::cerr << "JSON parse 错误: " << e.what() << std::endl;
+        return "invalid";
+    }
+}
 
-    std::string ParseTaskData(const std::string& data) {
-        try {
-            json parsedData = json::parse(data);
-            std::string taskType = parsedData["task_type"];
-            return taskType;
-        } catch (const json::parse_error& e) {
-            std::cerr << "JSON parse 错误: " << e.what() << std::endl;
-            return "invalid";
+std::size_t TaskSchedulerModule::GetParallelism(TaskRange range, std::size_t grain) const {
+    if (range.end <= range.begin) {
+        return 0;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+    const std::size_t chunks = (range.end - range.begin + grain - 1) / grain;
+    return std::min<std::size_t>(chunks, workers.size() + 1);
+}
+
+bool TaskSchedulerModule::ClaimChunk(std::atomic<std::size_t>& next, std::size_t end, std::size_t grain,
+                                     std::size_t participants, TaskRange& chunk) {
+    if (grain == 0) {
+        grain = 1;
+    }
+    std::size_t current = next.load(std::memory_order_relaxed);
+    while (current < end) {
+        // 剩余越少子区间越小，前期减少领取次数，后期保证负载均衡
+        const std::size_t remaining = end - current;
+        std::size_t size = std::max(grain, remaining / (participants * 2));
+        size = std::min(size, remaining);
+        if (next.compare_exchange_weak(current, current + size, std::memory_order_relaxed)) {
+            chunk = { current, current + size };
+            return true;
         }
     }
+    return false;
+}
 
-    void StopScheduler() {
-        std::cout << "Stopping TaskScheduler..." << std::endl;
+void TaskSchedulerModule::StopScheduler() {
+    std::cout << "Stopping TaskScheduler..." << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
         stop = true;
-        cv.notify_all();
     }
-};
+    cv.notify_all();
+}
 
 } // namespace GE
@@ -2,18 +2,102 @@
 #define TASKSCHEDULERMODULE_H
 
 #include "ModuleInterface.h"
+#include "WorkStealingDeque.h"
+#include "InlineTask.h"
 #include <functional>
 #include <future>
-#include <queue>
 #include <thread>
 #include <vector>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
 #include <string>
+#include <chrono>
+#include <optional>
+#include <algorithm>
+#include <type_traits>
+#include <cstdint>
 
 namespace GE {
 
+class TaskCounter;
+class TaskItemPool;
+
+// 队列中的任务项，由任务池回收复用
+struct TaskItem {
+    InlineTask func;
+    TaskCounter* counter = nullptr;
+    TaskItem* next = nullptr;
+    TaskItemPool* owner = nullptr;
+    TaskPriority priority = TaskPriority::Normal;
+    std::int64_t deadline = 0;
+};
+
+// 提交选项：优先级通道与可选截止时间
+// 截止时间落在当前帧内的任务会被提升到 Critical 通道
+struct TaskOptions {
+    TaskPriority priority = TaskPriority::Normal;
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+};
+
+// 每个提交线程独占的任务项池
+// 只有所属线程分配；其他线程释放时压入无锁的远程链表，所属线程取空本地链表后整体收回。
+class TaskItemPool {
+public:
+    TaskItemPool() = default;
+
+    TaskItemPool(const TaskItemPool&) = delete;
+    TaskItemPool& operator=(const TaskItemPool&) = delete;
+
+    // 仅所属线程调用
+    TaskItem* Allocate();
+
+    // 仅所属线程调用
+    void FreeLocal(TaskItem* item);
+
+    // 任意线程调用
+    void FreeRemote(TaskItem* item);
+
+private:
+    static constexpr std::size_t kBlockSize = 256;
+
+    TaskItem* localFree = nullptr;
+    std::atomic<TaskItem*> remoteFree{nullptr};
+    std::vector<std::unique_ptr<TaskItem[]>> blocks;
+};
+
+// 任务计数器：提交时加一，任务完成时减一，归零后触发挂在其上的后续任务
+class TaskCounter {
+public:
+    TaskCounter() : value(0) {}
+
+    TaskCounter(const TaskCounter&) = delete;
+    TaskCounter& operator=(const TaskCounter&) = delete;
+
+    void Add(int count) { value.fetch_add(count, std::memory_order_relaxed); }
+
+    bool IsDone() const { return value.load(std::memory_order_acquire) == 0; }
+
+    int GetValue() const { return value.load(std::memory_order_acquire); }
+
+private:
+    friend class TaskSchedulerModule;
+
+    std::atomic<int> value;
+    std::mutex continuationMutex;
+    TaskItem* continuations = nullptr;
+};
+
+template<typename T>
+class TaskHandle;
+
+// 并行算法的索引区间 [begin, end)
+struct TaskRange {
+    std::size_t begin;
+    std::size_t end;
+};
+
 class TaskSchedulerModule : public ModuleInterface {
 public:
     TaskSchedulerModule();
@@ -32,27 +116,191 @@ public:
     void processTask(const Task& task) override;
 
 
+    void update() override;
+
+
     template<typename Func, typename... Args>
     auto ScheduleTask(Func&& func, Args&&... args) -> std::future<typename std::result_of<Func(Args...)>::type>;
 
+    // 提交任务，counter 非空时在任务完成后递减；闭包不超过 64 字节时不做堆分配
+    template<typename Func>
+    void SubmitTask(Func&& func, TaskCounter* counter = nullptr, const TaskOptions& options = {});
+
+    // 提交带返回值的任务，结果写入 handle
+    template<typename Result, typename Func>
+    void SubmitTask(TaskHandle<Result>& handle, Func&& func, const TaskOptions& options = {});
+
+    // dependency 归零后任务才会进入队列
+    template<typename Func>
+    void SubmitTaskAfter(TaskCounter& dependency, Func&& func, TaskCounter* counter = nullptr, const TaskOptions& options = {});
+
+    // 等待计数器归零，期间当前线程协助执行其他任务而不是阻塞
+    void WaitForCounter(TaskCounter& counter);
+
+    // 手动递减计数器，用于不经过调度器完成的工作
+    void SignalCounter(TaskCounter& counter);
+
+    // 并行遍历区间，func 接受 (begin, end) 子区间或单个索引。
+    // 调用线程参与执行；子区间大小随剩余量自适应缩小，但不小于 grain。
+    template<typename Func>
+    void ParallelFor(TaskRange range, std::size_t grain, Func&& func);
+
+    // 并行归约，map 接受 (begin, end) 子区间或单个索引并返回 T，reduce 合并两个 T
+    // reduce 须满足结合律；identity 无论并行度多少都只参与一次合并，可以是非中性的初始值
+    template<typename T, typename MapFunc, typename ReduceFunc>
+    T ParallelReduce(TaskRange range, std::size_t grain, T identity, MapFunc&& map, ReduceFunc&& reduce);
+
+    // 设置帧预算：frameBudget 决定帧截止时间，后台通道在一帧内累计执行超过 backgroundBudget 后暂停领取
+    // backgroundBudget 为 0 表示不限制
+    void SetFrameBudget(std::chrono::nanoseconds frameBudget, std::chrono::nanoseconds backgroundBudget);
+
+    // 标记新的一帧开始，重置后台预算
+    void BeginFrame();
+
+    // 开始执行时已超过截止时间的任务数量
+    std::uint64_t GetMissedDeadlineCount() const;
+
+    // 工作线程数量
+    unsigned int GetWorkerCount() const;
+
+    // 当前线程在本调度器中的工作线程索引，非工作线程返回 -1
+    int GetCurrentWorkerIndex() const;
+
 private:
-    std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
+    // 每个工作线程拥有一个 Chase-Lev 队列，本线程产生的任务直接压入
+    // 由工作线程在绑核后自行创建，队列内存按首次访问落在本地 NUMA 节点
+    struct Worker {
+        WorkStealingDeque<TaskItem*> deques[kTaskPriorityCount];
+        TaskItemPool pool;
+    };
+
+    const std::uint64_t schedulerId;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> workerThreads;
+    std::atomic<unsigned int> readyWorkers;
+
+    // 非工作线程提交的任务按通道进入全局注入队列（侵入式链表）
+    TaskItem* injectHead[kTaskPriorityCount];
+    TaskItem* injectTail[kTaskPriorityCount];
+    std::atomic<std::size_t> injectCount[kTaskPriorityCount];
     std::mutex queueMutex;
+
+    // 帧预算，时间均为 steady_clock 纳秒
+    std::atomic<std::int64_t> frameBudgetNs;
+    std::atomic<std::int64_t> backgroundBudgetNs;
+    std::atomic<std::int64_t> frameDeadlineNs;
+    std::atomic<std::int64_t> backgroundTimeNs;
+    std::atomic<std::uint64_t> missedDeadlines;
+
+    // 非工作线程各自的任务池
+    std::vector<std::unique_ptr<TaskItemPool>> externalPools;
+    std::mutex poolMutex;
+
     std::condition_variable cv;
+    std::atomic<unsigned int> sleepingWorkers;
     std::atomic<bool> stop;
 
 
-    void EnqueueTask(std::function<void()> func);
+    // 从当前线程的任务池取任务项
+    TaskItem* AllocateTask(const TaskOptions& options);
+
+
+    TaskItemPool* GetCurrentPool();
+
+
+    void ReleaseTask(TaskItem* task);
+
+
+    void PushTask(TaskItem* task);
+
+
+    void DeferTask(TaskCounter& dependency, TaskItem* task);
+
+
+    void RunTask(TaskItem* task);
+
+
+    void WorkerThreadFunc(unsigned int index);
+
+
+    // 按通道优先级依次尝试：本地队列、注入队列、窃取其他工作线程
+    // allowThrottled 为真时忽略后台预算（等待计数器的线程必须能推进任何任务）
+    TaskItem* FindTask(int index, bool allowThrottled = false);
+
 
+    bool HasPendingTask(bool includeThrottled = false) const;
 
-    void WorkerThreadFunc();
+
+    bool IsBackgroundThrottled() const;
+
+
+    void WakeWorker();
 
 
     void StopScheduler();
 
 
     std::string ParseTaskData(const std::string& data);
+
+
+    std::size_t GetParallelism(TaskRange range, std::size_t grain) const;
+
+
+    // 从共享游标领取下一个子区间
+    static bool ClaimChunk(std::atomic<std::size_t>& next, std::size_t end, std::size_t grain,
+                           std::size_t participants, TaskRange& chunk);
+
+
+    template<typename Func>
+    static void InvokeRange(Func& func, TaskRange chunk);
+
+
+    template<typename T, typename MapFunc, typename ReduceFunc>
+    static T MapRange(MapFunc& map, ReduceFunc& reduce, T accumulator, TaskRange chunk);
+
+
+    // 不带初始值地归约一个非空子区间
+    template<typename T, typename MapFunc, typename ReduceFunc>
+    static T MapChunk(MapFunc& map, ReduceFunc& reduce, TaskRange chunk);
+};
+
+
+// 轻量完成句柄：结果存放在句柄内部，提交与等待都不做堆分配。
+// 句柄不可移动，必须存活到任务完成。
+template<typename T>
+class TaskHandle {
+public:
+    TaskHandle() = default;
+
+    bool IsReady() const { return counter.IsDone(); }
+
+    // 等待完成并取得结果，等待期间协助执行其他任务
+    T& Get(TaskSchedulerModule& scheduler) {
+        scheduler.WaitForCounter(counter);
+        return *result;
+    }
+
+private:
+    friend class TaskSchedulerModule;
+
+    TaskCounter counter;
+    std::optional<T> result;
+};
+
+template<>
+class TaskHandle<void> {
+public:
+    TaskHandle() = default;
+
+    bool IsReady() const { return counter.IsDone(); }
+
+    void Get(TaskSchedulerModule& scheduler) { scheduler.WaitForCounter(counter); }
+
+private:
+    friend class TaskSchedulerModule;
+
+    TaskCounter counter;
 };
 
 
@@ -65,14 +313,144 @@ auto TaskSchedulerModule::ScheduleTask(Func&& func, Args&&... args) -> std::futu
     );
 
     std::future<return_type> res = task->get_future();
-    {
-        std::lock_guard<std::mutex> lock(queueMutex);
-        tasks.emplace([task]() { (*task)(); });
-    }
-    cv.notify_one();
+    SubmitTask([task]() { (*task)(); });
 
     return res;
 }
 
+template<typename Func>
+void TaskSchedulerModule::SubmitTask(Func&& func, TaskCounter* counter, const TaskOptions& options) {
+    if (counter) {
+        counter->Add(1);
+    }
+    TaskItem* task = AllocateTask(options);
+    task->func = InlineTask(std::forward<Func>(func));
+    task->counter = counter;
+    PushTask(task);
+}
+
+template<typename Result, typename Func>
+void TaskSchedulerModule::SubmitTask(TaskHandle<Result>& handle, Func&& func, const TaskOptions& options) {
+    if constexpr (std::is_void<Result>::value) {
+        SubmitTask(std::forward<Func>(func), &handle.counter, options);
+    } else {
+        SubmitTask([&handle, fn = std::forward<Func>(func)]() mutable { handle.result.emplace(fn()); }, &handle.counter, options);
+    }
+}
+
+template<typename Func>
+void TaskSchedulerModule::SubmitTaskAfter(TaskCounter& dependency, Func&& func, TaskCounter* counter, const TaskOptions& options) {
+    if (counter) {
+        counter->Add(1);
+    }
+    TaskItem* task = AllocateTask(options);
+    task->func = InlineTask(std::forward<Func>(func));
+    task->counter = counter;
+    DeferTask(dependency, task);
+}
+template<typename Func>
+void TaskSchedulerModule::ParallelFor(TaskRange range, std::size_t grain, Func&& func) {
+    const std::size_t participants = GetParallelism(range, grain);
+    if (participants == 0) {
+        return;
+    }
+    if (participants == 1) {
+        InvokeRange(func, range);
+        return;
+    }
+
+    std::atomic<std::size_t> next{range.begin};
+    auto runChunks = [&]() {
+        TaskRange chunk{};
+        while (ClaimChunk(next, range.end, grain, participants, chunk)) {
+            InvokeRange(func, chunk);
+        }
+    };
+
+    TaskCounter counter;
+    for (std::size_t i = 1; i < participants; ++i) {
+        SubmitTask([&runChunks]() { runChunks(); }, &counter);
+    }
+    runChunks();
+    WaitForCounter(counter);
+}
+
+template<typename T, typename MapFunc, typename ReduceFunc>
+T TaskSchedulerModule::ParallelReduce(TaskRange range, std::size_t grain, T identity, MapFunc&& map, ReduceFunc&& reduce) {
+    const std::size_t participants = GetParallelism(range, grain);
+    if (participants == 0) {
+        return identity;
+    }
+    if (participants == 1) {
+        return MapRange(map, reduce, std::move(identity), range);
+    }
+
+    std::atomic<std::size_t> next{range.begin};
+    std::mutex resultMutex;
+    std::optional<T> result;
+    auto runChunks = [&]() {
+        // 参与者的部分结果从第一个子区间开始累积，不重复折入 identity
+        std::optional<T> local;
+        TaskRange chunk{};
+        while (ClaimChunk(next, range.end, grain, participants, chunk)) {
+            if (local) {
+                local = MapRange(map, reduce, std::move(*local), chunk);
+            } else {
+                local = MapChunk<T>(map, reduce, chunk);
+            }
+        }
+        if (!local) {
+            return;
+        }
+        // 每个参与者只合并一次
+        std::lock_guard<std::mutex> lock(resultMutex);
+        result = result ? reduce(std::move(*result), std::move(*local)) : std::move(*local);
+    };
+
+    TaskCounter counter;
+    for (std::size_t i = 1; i < participants; ++i) {
+        SubmitTask([&runChunks]() { runChunks(); }, &counter);
+    }
+    runChunks();
+    WaitForCounter(counter);
+    return result ? reduce(std::move(identity), std::move(*result)) : identity;
+}
+
+template<typename Func>
+void TaskSchedulerModule::InvokeRange(Func& func, TaskRange chunk) {
+    if constexpr (std::is_invocable<Func&, std::size_t, std::size_t>::value) {
+        func(chunk.begin, chunk.end);
+    } else {
+        for (std::size_t i = chunk.begin; i < chunk.end; ++i) {
+            func(i);
+        }
+    }
+}
+
+template<typename T, typename MapFunc, typename ReduceFunc>
+T TaskSchedulerModule::MapRange(MapFunc& map, ReduceFunc& reduce, T accumulator, TaskRange chunk) {
+    if constexpr (std::is_invocable<MapFunc&, std::size_t, std::size_t>::value) {
+        return reduce(std::move(accumulator), map(chunk.begin, chunk.end));
+    } else {
+        for (std::size_t i = chunk.begin; i < chunk.end; ++i) {
+            accumulator = reduce(std::move(accumulator), map(i));
+        }
+        return accumulator;
+    }
+}
+
+template<typename T, typename MapFunc, typename ReduceFunc>
+T TaskSchedulerModule::MapChunk(MapFunc& map, ReduceFunc& reduce, TaskRange chunk) {
+    if constexpr (std::is_invocable<MapFunc&, std::size_t, std::size_t>::value) {
+        return map(chunk.begin, chunk.end);
+    } else {
+        T accumulator = map(chunk.begin);
+        for (std::size_t i = chunk.begin + 1; i < chunk.end; ++i) {
+            accumulator = reduce(std::move(accumulator), map(i));
+        }
+        return accumulator;
+    }
+}
+
 }
 #endif // TASKSCHEDULERMODULE_H
@@ -0,0 +1,234 @@
+#include "ThreadTopology.h"
+#include "Profiler.h"
+#include "Settings.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+#ifdef __linux__
+    #include <sched.h>
+    #include <sys/syscall.h>
+    #include <linux/mempolicy.h>
+#endif
+
+namespace GE {
+
+namespace {
+    // 解析 sysfs 中的 CPU 列表格式，例如 "0-3,8-11"
+    std::vector<int> ParseCpuList(const std::string& text) {
+        std::vector<int> result;
+        std::stringstream stream(text);
+        std::string range;
+        while (std::getline(stream, range, ',')) {
+            if (range.empty()) continue;
+            std::size_t dash = range.find('-');
+            try {
+                int first = std::stoi(range.substr(0, dash));
+                int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    result.push_back(cpu);
+                }
+            } catch (const std::exception&) {
+                break;
+            }
+        }
+        return result;
+    }
+
+    std::string ReadFirstLine(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+
+    const std::size_t kPoolCount = 3;
+}
+
+ThreadTopology& ThreadTopology::Get() {
+    static ThreadTopology instance;
+    return instance;
+}
+
+ThreadTopology::ThreadTopology() : numaNodeCount(1), pinThreads(false) {
+    DetectCores();
+
+    const Settings& settings = Settings::Get();
+    int maxThreads = settings.GetInt("performance.max_threads", static_cast<int>(cores.size()));
+    if (!settings.GetBool("performance.multi_threading", true)) {
+        maxThreads = 1;
+    }
+    Configure(static_cast<unsigned int>(std::max(maxThreads, 1)), settings.GetBool("performance.pin_threads", true));
+}
+
+void ThreadTopology::DetectCores() {
+    cores.clear();
+#ifdef _WIN32
+    DWORD count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    for (DWORD cpu = 0; cpu < count; ++cpu) {
+        cores.push_back({ static_cast<int>(cpu), 0, true });
+    }
+#elif defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        unsigned int count = std::max(std::thread::hardware_concurrency(), 1u);
+        for (unsigned int cpu = 0; cpu < count; ++cpu) {
+            CPU_SET(cpu, &allowed);
+        }
+    }
+
+    // NUMA 节点归属
+    std::vector<int> cpuNode(CPU_SETSIZE, 0);
+    for (int node = 0; node < 1024; ++node) {
+        std::string list = ReadFirstLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (list.empty()) {
+            if (node > 0) break;
+            continue;
+        }
+        numaNodeCount = node + 1;
+        for (int cpu : ParseCpuList(list)) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) cpuNode[cpu] = node;
+        }
+    }
+
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &allowed)) continue;
+        std::vector<int> siblings = ParseCpuList(ReadFirstLine(
+            "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/thread_siblings_list"));
+        bool primary = siblings.empty() || siblings.front() == cpu;
+        cores.push_back({ cpu, cpuNode[cpu], primary });
+    }
+#else
+    // 其他平台不读取拓扑，按单 NUMA 节点、无超线程处理
+    unsigned int count = std::max(std::thread::hardware_concurrency(), 1u);
+    for (unsigned int cpu = 0; cpu < count; ++cpu) {
+        cores.push_back({ static_cast<int>(cpu), 0, true });
+    }
+#endif
+
+    if (cores.empty()) {
+        cores.push_back({ 0, 0, true });
+    }
+
+    // 先物理核心再超线程，同一节点的核心相邻，使同一池尽量落在同一节点
+    std::stable_sort(cores.begin(), cores.end(), [](const CpuCore& a, const CpuCore& b) {
+        if (a.primary != b.primary) return a.primary;
+        return a.numaNode < b.numaNode;
+    });
+}
+
+void ThreadTopology::Configure(unsigned int maxThreads, bool pin) {
+    pinThreads = pin;
+
+    // 预算不超过可用核心数，保证各池之间不会超额订阅
+    unsigned int budget = std::min<unsigned int>(maxThreads, static_cast<unsigned int>(cores.size()));
+    budget = std::max(budget, 1u);
+
+    // IO 池至少一个线程，阻塞读取不能落在提交加载的主循环上；IO 线程大部分时间在等待磁盘，预算很小时允许多出这一个线程。
+    // 预算不足 4 时 Fiber 池不单独建线程，其工作由提交或等待的线程执行
+    unsigned int io = std::max(1u, budget / 8);
+    unsigned int fiber = budget >= 4 ? std::max(1u, budget / 4) : 0;
+    // 预留一个核心给主线程；计算池至少一个线程，阻塞在 ScheduleTask 返回的 future 上的线程不会帮忙执行任务
+    unsigned int reserved = io + fiber + 1;
+    unsigned int compute = budget > reserved ? budget - reserved : 1;
+
+    const unsigned int counts[kPoolCount] = { compute, io, fiber };
+    std::size_t next = cores.size() > 1 ? 1 : 0;
+    for (std::size_t pool = 0; pool < kPoolCount; ++pool) {
+        poolCores[pool].clear();
+        for (unsigned int i = 0; i < counts[pool]; ++i) {
+            poolCores[pool].push_back(next % cores.size());
+            ++next;
+        }
+    }
+
+    std::cout << "线程拓扑: " << cores.size() << " cores, " << numaNodeCount << " NUMA nodes, compute "
+              << compute << ", io " << io << ", fiber " << fiber << std::endl;
+}
+
+unsigned int ThreadTopology::GetThreadCount(ThreadPoolType pool) const {
+    return static_cast<unsigned int>(poolCores[static_cast<std::size_t>(pool)].size());
+}
+
+const ThreadTopology::CpuCore& ThreadTopology::GetCore(ThreadPoolType pool, unsigned int index) const {
+    const auto& assigned = poolCores[static_cast<std::size_t>(pool)];
+    if (assigned.empty()) {
+        return cores.front();
+    }
+    return cores[assigned[index % assigned.size()]];
+}
+
+bool ThreadTopology::PinCurrentThread(ThreadPoolType pool, unsigned int index) const {
+    if (!pinThreads) {
+        return false;
+    }
+    const CpuCore& core = GetCore(pool, index);
+
+#ifdef _WIN32
+    if (core.cpu >= 64) {
+        return false;
+    }
+    return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << core.cpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core.cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        std::cerr << "绑定线程到 CPU " << core.cpu << " 失败" << std::endl;
+        return false;
+    }
+    if (numaNodeCount > 1) {
+        SetPreferredNumaNode(core.numaNode);
+    }
+    return true;
+#else
+    // macOS 等平台不支持把线程绑定到指定核心
+    (void)core;
+    return false;
+#endif
+}
+
+void ThreadTopology::SetCurrentThreadName(const std::string& name) {
+    GE_PROFILE_THREAD(name);
+#ifdef __linux__
+    // Linux 线程名最长 15 个字符
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#else
+    (void)name;
+#endif
+}
+
+std::size_t ThreadTopology::GetCoreCount() const {
+    return cores.size();
+}
+
+int ThreadTopology::GetNumaNodeCount() const {
+    return numaNodeCount;
+}
+
+bool ThreadTopology::SetPreferredNumaNode(int node) {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    if (node < 0 || node >= 256) {
+        return false;
+    }
+    // 之后由该线程首次访问的页面优先分配在本地节点
+    unsigned long mask[256 / (8 * sizeof(unsigned long))] = {};
+    mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+    return syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask, sizeof(mask) * 8 + 1) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+} // namespace GE
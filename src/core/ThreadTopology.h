@@ -0,0 +1,65 @@
+#ifndef THREADTOPOLOGY_H
+#define THREADTOPOLOGY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace GE {
+
+// 引擎线程池类型，各池分得互不重叠的核心
+enum class ThreadPoolType { Compute, IO, Fiber };
+
+// 线程拓扑服务
+// 统一探测 CPU/NUMA 拓扑，按 performance.max_threads 把线程预算划分给计算、IO 和 Fiber 池，
+// 并负责把线程绑定到核心、让线程优先从本地 NUMA 节点分配内存。
+class ThreadTopology {
+public:
+    struct CpuCore {
+        int cpu;        // 逻辑 CPU 编号
+        int numaNode;   // 所属 NUMA 节点
+        bool primary;   // 是否为物理核心上的第一个超线程
+    };
+
+    // 全局拓扑，首次调用时探测硬件并读取配置
+    static ThreadTopology& Get();
+
+    // 按线程总预算重新划分各池（包含主线程）
+    void Configure(unsigned int maxThreads, bool pinThreads);
+
+    // Fiber 池可能为 0：预算不足 4 时 Fiber 任务由提交或等待的线程执行；IO 池至少一个线程
+    unsigned int GetThreadCount(ThreadPoolType pool) const;
+
+    // 池中第 index 个线程对应的核心
+    const CpuCore& GetCore(ThreadPoolType pool, unsigned int index) const;
+
+    // 把当前线程绑定到池中第 index 个线程对应的核心，并设置本地 NUMA 内存策略
+    bool PinCurrentThread(ThreadPoolType pool, unsigned int index) const;
+
+    // 为当前线程设置名称，便于调试器和性能工具识别
+    static void SetCurrentThreadName(const std::string& name);
+
+    std::size_t GetCoreCount() const;
+
+    int GetNumaNodeCount() const;
+
+private:
+    ThreadTopology();
+
+    std::vector<CpuCore> cores;
+    int numaNodeCount;
+    bool pinThreads;
+
+    // 每个池分得的核心在 cores 中的下标
+    std::vector<std::size_t> poolCores[3];
+
+
+    void DetectCores();
+
+
+    static bool SetPreferredNumaNode(int node);
+};
+
+} // namespace GE
+
+#endif // THREADTOPOLOGY_H
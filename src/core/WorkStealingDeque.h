@@ -0,0 +1,135 @@
+#ifndef WORKSTEALINGDEQUE_H
+#define WORKSTEALINGDEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace GE {
+
+// Chase-Lev 无锁工作窃取双端队列
+// 所有者线程在底部 Push/Pop（LIFO），其他线程从顶部 Steal（FIFO）。
+// T 必须是可平凡复制的小类型（通常为指针）。
+template<typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(std::size_t capacity = 1024)
+        : top(0), bottom(0) {
+        std::size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        auto initial = std::make_unique<Array>(cap);
+        array.store(initial.get(), std::memory_order_relaxed);
+        arrays.push_back(std::move(initial));
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // 仅所有者线程调用
+    void Push(T item) {
+        std::int64_t b = bottom.load(std::memory_order_relaxed);
+        std::int64_t t = top.load(std::memory_order_acquire);
+        Array* a = array.load(std::memory_order_relaxed);
+        if (b - t > static_cast<std::int64_t>(a->capacity) - 1) {
+            a = Grow(a, t, b);
+        }
+        a->Put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // 仅所有者线程调用
+    bool Pop(T& out) {
+        std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Array* a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = a->Get(b);
+        if (t == b) {
+            // 最后一个元素，与窃取者竞争
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // 任意线程调用
+    bool Steal(T& out) {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return false;
+        }
+
+        Array* a = array.load(std::memory_order_acquire);
+        T item = a->Get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        out = item;
+        return true;
+    }
+
+    bool Empty() const {
+        std::int64_t b = bottom.load(std::memory_order_relaxed);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+        return b <= t;
+    }
+
+    std::size_t Size() const {
+        std::int64_t b = bottom.load(std::memory_order_relaxed);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+
+private:
+    struct Array {
+        explicit Array(std::size_t cap)
+            : capacity(cap), mask(cap - 1), buffer(new std::atomic<T>[cap]) {}
+
+        T Get(std::int64_t i) const {
+            return buffer[static_cast<std::size_t>(i) & mask].load(std::memory_order_relaxed);
+        }
+
+        void Put(std::int64_t i, T item) {
+            buffer[static_cast<std::size_t>(i) & mask].store(item, std::memory_order_relaxed);
+        }
+
+        std::size_t capacity;
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T>[]> buffer;
+    };
+
+    // 扩容时旧数组可能仍被窃取者读取，因此保留到队列销毁
+    Array* Grow(Array* old, std::int64_t t, std::int64_t b) {
+        auto grown = std::make_unique<Array>(old->capacity * 2);
+        for (std::int64_t i = t; i < b; ++i) {
+            grown->Put(i, old->Get(i));
+        }
+        Array* raw = grown.get();
+        arrays.push_back(std::move(grown));
+        array.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    alignas(64) std::atomic<std::int64_t> top;
+    alignas(64) std::atomic<std::int64_t> bottom;
+    alignas(64) std::atomic<Array*> array;
+    std::vector<std::unique_ptr<Array>> arrays;
+};
+
+} // namespace GE
+
+#endif // WORKSTEALINGDEQUE_H
@@ -0,0 +1,190 @@
+// 内存池多线程基准：比较 MemoryManagerModule 与 operator new/delete 的分配释放速度，
+// 并测量内存统计的开销：池分配路径上不计数，开销只在每帧一次的 GetMemoryStats
+// 用法: GalaxyMemoryPoolBench [线程数] [每线程轮数]
+#include <core/MemoryManager.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // 每轮先分配一批再全部释放，大小覆盖小对象常见的几个大小类别
+    constexpr std::size_t kBatchSize = 64;
+    constexpr std::size_t kSizes[] = { 16, 24, 32, 48, 64, 96, 128, 256, 512, 1024 };
+
+    std::size_t GetSize(std::size_t index) {
+        return kSizes[index % (sizeof(kSizes) / sizeof(kSizes[0]))];
+    }
+
+    struct Allocator {
+        const char* name;
+        void* (*allocate)(std::size_t size);
+        void (*free)(void* ptr, std::size_t size);
+    };
+
+    const Allocator kAllocators[] = {
+        { "operator new",
+          [](std::size_t size) { return ::operator new(size); },
+          [](void* ptr, std::size_t) { ::operator delete(ptr); } },
+        { "MemoryManager",
+          [](std::size_t size) { return GE::MemoryManagerModule::GetDefault().AllocateMemory(size); },
+          [](void* ptr, std::size_t size) { GE::MemoryManagerModule::GetDefault().FreeMemory(ptr, size); } },
+    };
+
+    // 所有线程同时开始，返回每次分配加释放的平均纳秒数
+    template<typename Func>
+    double RunThreads(unsigned int threadCount, std::size_t operationCount, Func func) {
+        std::atomic<unsigned int> ready{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < threadCount; ++i) {
+            threads.emplace_back([&, i]() {
+                ready.fetch_add(1);
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                func(i);
+            });
+        }
+        while (ready.load() < threadCount) {
+            std::this_thread::yield();
+        }
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return elapsedNs * threadCount / static_cast<double>(operationCount);
+    }
+
+    // 每个线程分配和释放自己的内存
+    double LocalAllocFree(const Allocator& allocator, unsigned int threadCount, int rounds) {
+        return RunThreads(threadCount, static_cast<std::size_t>(threadCount) * rounds * kBatchSize, [&](unsigned int) {
+            void* blocks[kBatchSize];
+            for (int round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < kBatchSize; ++i) {
+                    blocks[i] = allocator.allocate(GetSize(i + round));
+                }
+                for (std::size_t i = 0; i < kBatchSize; ++i) {
+                    allocator.free(blocks[i], GetSize(i + round));
+                }
+            }
+        });
+    }
+
+    // 线程数个线程在每个标签的每个大小类别池中都用过弹匣并保持存活时，GetMemoryStats 的平均微秒数
+    double CollectMicroseconds(unsigned int threadCount) {
+        GE::MemoryManagerModule& memoryManager = GE::MemoryManagerModule::GetDefault();
+        std::atomic<unsigned int> ready{0};
+        std::atomic<bool> done{false};
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < threadCount; ++i) {
+            threads.emplace_back([&]() {
+                for (std::size_t tag = 0; tag < GE::kMemoryTagCount; ++tag) {
+                    for (std::size_t index = 0; index < GE::MemorySizeClasses::kClassCount; ++index) {
+                        std::size_t size = GE::MemorySizeClasses::GetClassSize(index);
+                        void* block = memoryManager.AllocateMemory(size, static_cast<GE::MemoryTag>(tag));
+                        memoryManager.FreeMemory(block, size, static_cast<GE::MemoryTag>(tag));
+                    }
+                }
+                ready.fetch_add(1);
+                while (!done.load()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            });
+        }
+        while (ready.load() < threadCount) {
+            std::this_thread::yield();
+        }
+        const int collectCount = 100;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < collectCount; ++i) {
+            memoryManager.GetMemoryStats();
+        }
+        double elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        done.store(true);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return elapsedUs / collectCount;
+    }
+
+    // 线程两两配对，各自分配的内存交给对方释放，模拟跨线程传递的资源和消息
+    double CrossThreadFree(const Allocator& allocator, unsigned int threadCount, int rounds) {
+        threadCount = std::max(2u, threadCount & ~1u);
+        struct Mailbox {
+            std::mutex mutex;
+            std::vector<std::vector<void*>> batches;
+        };
+        std::vector<Mailbox> mailboxes(threadCount);
+        return RunThreads(threadCount, static_cast<std::size_t>(threadCount) * rounds * kBatchSize, [&](unsigned int index) {
+            Mailbox& outgoing = mailboxes[index ^ 1u];
+            Mailbox& incoming = mailboxes[index];
+            int freed = 0;
+            auto drain = [&]() {
+                std::vector<std::vector<void*>> batches;
+                {
+                    std::lock_guard<std::mutex> lock(incoming.mutex);
+                    batches.swap(incoming.batches);
+                }
+                for (const auto& batch : batches) {
+                    for (std::size_t i = 0; i < batch.size(); ++i) {
+                        allocator.free(batch[i], GetSize(i));
+                    }
+                    ++freed;
+                }
+            };
+            for (int round = 0; round < rounds; ++round) {
+                std::vector<void*> batch(kBatchSize);
+                for (std::size_t i = 0; i < kBatchSize; ++i) {
+                    batch[i] = allocator.allocate(GetSize(i));
+                }
+                {
+                    std::lock_guard<std::mutex> lock(outgoing.mutex);
+                    outgoing.batches.push_back(std::move(batch));
+                }
+                drain();
+            }
+            while (freed < rounds) {
+                std::this_thread::yield();
+                drain();
+            }
+        });
+    }
+}
+
+int main(int argc, char* argv[]) {
+    unsigned int threadCount = argc > 1 ? static_cast<unsigned int>(std::stoul(argv[1])) : std::thread::hardware_concurrency();
+    threadCount = std::max(threadCount, 1u);
+    const int rounds = argc > 2 ? std::max(std::stoi(argv[2]), 1) : 100000;
+
+    // 先初始化默认模块，避免首次分配的初始化计入结果
+    GE::MemoryManagerModule::GetDefault();
+
+    std::cout << threadCount << " 个线程, 每线程 " << rounds << " 轮, 每轮 " << kBatchSize << " 次分配" << std::endl;
+    for (const Allocator& allocator : kAllocators) {
+        // 预热一轮，使线程缓存和池中的 slab 就绪
+        LocalAllocFree(allocator, threadCount, std::max(rounds / 10, 1));
+        double local = LocalAllocFree(allocator, threadCount, rounds);
+        double cross = CrossThreadFree(allocator, threadCount, rounds);
+        std::cout << allocator.name << ": 本线程释放 " << local << " ns/次, 跨线程释放 " << cross << " ns/次" << std::endl;
+    }
+
+#ifdef GE_ENABLE_MEMORY_TRACKING
+    // 引擎每帧调用一次 MemoryManagerModule::update，其中汇总一次统计
+    const double frameUs = 1e6 / 60.0;
+    double collectUs = CollectMicroseconds(threadCount);
+    std::cout << "内存统计: 池分配路径不计数, GetMemoryStats " << collectUs << " us/次, 每帧一次占 60 FPS 帧时间的 "
+              << collectUs / frameUs * 100.0 << "%" << std::endl;
+#else
+    std::cout << "未定义 GE_ENABLE_MEMORY_TRACKING，内存统计已编译掉" << std::endl;
+#endif
+    return 0;
+}
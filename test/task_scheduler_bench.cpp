@@ -0,0 +1,186 @@
+// 任务调度器吞吐量基准：比较工作窃取调度器的 SubmitTask 与原先单队列实现的 ScheduleTask 每秒执行的任务数
+// 用法: GalaxyTaskSchedulerBench [任务数]
+#include <core/TaskScheduler.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // 原先的调度器，与最初的 TaskSchedulerModule 相同：hardware_concurrency 个线程共享一个加锁的 std::function 队列；
+    // ScheduleTask 每次提交都分配 packaged_task 和 future 的共享状态，经 std::bind 包装后再装入 std::function
+    class LegacyTaskScheduler {
+    public:
+        LegacyTaskScheduler() : stop(false) {
+            unsigned int threadCount = std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 4;
+            for (unsigned int i = 0; i < threadCount; ++i) {
+                workers.emplace_back(&LegacyTaskScheduler::WorkerThreadFunc, this);
+            }
+        }
+
+        ~LegacyTaskScheduler() {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                stop = true;
+            }
+            cv.notify_all();
+            for (auto& worker : workers) {
+                if (worker.joinable()) {
+                    worker.join();
+                }
+            }
+        }
+
+        unsigned int GetWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+
+        template<typename Func, typename... Args>
+        auto ScheduleTask(Func&& func, Args&&... args) -> std::future<typename std::result_of<Func(Args...)>::type> {
+            using return_type = typename std::result_of<Func(Args...)>::type;
+
+            auto task = std::make_shared<std::packaged_task<return_type()>>(
+                std::bind(std::forward<Func>(func), std::forward<Args>(args)...)
+            );
+
+            std::future<return_type> res = task->get_future();
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                tasks.emplace([task]() { (*task)(); });
+            }
+            cv.notify_one();
+            return res;
+        }
+
+    private:
+        std::vector<std::thread> workers;
+        std::queue<std::function<void()>> tasks;
+        std::mutex queueMutex;
+        std::condition_variable cv;
+        std::atomic<bool> stop;
+
+        void WorkerThreadFunc() {
+            while (true) {
+                std::function<void()> taskFunc;
+                {
+                    std::unique_lock<std::mutex> lock(queueMutex);
+                    cv.wait(lock, [this]() { return stop.load() || !tasks.empty(); });
+                    if (stop.load() && tasks.empty()) {
+                        break;
+                    }
+                    if (!tasks.empty()) {
+                        taskFunc = std::move(tasks.front());
+                        tasks.pop();
+                    }
+                }
+                if (taskFunc) {
+                    taskFunc();
+                }
+            }
+        }
+    };
+
+    // 每个根任务再提交的子任务数，模拟任务在工作线程上继续派生
+    constexpr int kChildrenPerTask = 16;
+
+    double MillionJobsPerSecond(int jobCount, std::chrono::steady_clock::duration elapsed) {
+        return jobCount / std::chrono::duration<double>(elapsed).count() / 1e6;
+    }
+
+    void Report(const char* name, int jobCount, std::chrono::steady_clock::duration legacy, std::chrono::steady_clock::duration current) {
+        double legacyRate = MillionJobsPerSecond(jobCount, legacy);
+        double currentRate = MillionJobsPerSecond(jobCount, current);
+        std::cout << name << ": 原调度器 " << legacyRate << " M/s, 调度器 " << currentRate
+                  << " M/s, 加速 " << currentRate / legacyRate << "x" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int jobCount = argc > 1 ? std::max(std::stoi(argv[1]), kChildrenPerTask + 1) : 1000000;
+    const int rootCount = jobCount / (kChildrenPerTask + 1);
+    const int nestedJobCount = rootCount * (kChildrenPerTask + 1);
+
+    GE::TaskSchedulerModule scheduler;
+    scheduler.initialize();
+    const unsigned int threadCount = scheduler.GetWorkerCount();
+
+    std::chrono::steady_clock::duration legacyFlat;
+    std::chrono::steady_clock::duration legacyNested;
+    unsigned int legacyThreadCount;
+    {
+        LegacyTaskScheduler legacy;
+        legacyThreadCount = legacy.GetWorkerCount();
+
+        // 原先的调用方通过返回的 future 等待
+        std::atomic<int> legacyExecuted{0};
+        std::vector<std::future<void>> futures;
+        futures.reserve(jobCount);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < jobCount; ++i) {
+            futures.push_back(legacy.ScheduleTask([&legacyExecuted]() { legacyExecuted.fetch_add(1, std::memory_order_relaxed); }));
+        }
+        for (auto& future : futures) {
+            future.wait();
+        }
+        legacyFlat = std::chrono::steady_clock::now() - start;
+        futures.clear();
+
+        // 子任务的 future 直接丢弃，用计数等待全部完成
+        std::atomic<int> remaining{nestedJobCount};
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < rootCount; ++i) {
+            futures.push_back(legacy.ScheduleTask([&legacy, &remaining]() {
+                for (int child = 0; child < kChildrenPerTask; ++child) {
+                    legacy.ScheduleTask([&remaining]() { remaining.fetch_sub(1, std::memory_order_relaxed); });
+                }
+                remaining.fetch_sub(1, std::memory_order_relaxed);
+            }));
+        }
+        for (auto& future : futures) {
+            future.wait();
+        }
+        while (remaining.load(std::memory_order_acquire) > 0) {
+            std::this_thread::yield();
+        }
+        legacyNested = std::chrono::steady_clock::now() - start;
+    }
+
+    std::atomic<int> executed{0};
+    GE::TaskCounter counter;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < jobCount; ++i) {
+        scheduler.SubmitTask([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    scheduler.WaitForCounter(counter);
+    auto currentFlat = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rootCount; ++i) {
+        scheduler.SubmitTask([&scheduler, &executed, &counter]() {
+            for (int child = 0; child < kChildrenPerTask; ++child) {
+                scheduler.SubmitTask([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+            }
+            executed.fetch_add(1, std::memory_order_relaxed);
+        }, &counter);
+    }
+    scheduler.WaitForCounter(counter);
+    auto currentNested = std::chrono::steady_clock::now() - start;
+    scheduler.shutdown();
+
+    if (executed.load() != jobCount + nestedJobCount) {
+        std::cerr << "执行的任务数不符: " << executed.load() << std::endl;
+        return 1;
+    }
+    std::cout << "原调度器 " << legacyThreadCount << " 个工作线程, 调度器 " << threadCount << " 个工作线程, " << jobCount << " 个任务" << std::endl;
+    Report("主线程提交", jobCount, legacyFlat, currentFlat);
+    Report("任务内派生", nestedJobCount, legacyNested, currentNested);
+    return 0;
+}
@@ -0,0 +1,69 @@
+// 资源打包工具：把目录下的所有文件打成一个 GalaxyEngine 资源包
+// 用法: GalaxyAssetPacker <输入目录> <输出文件> [--prefix 包内路径前缀] [--align 对齐字节数] [--compress]
+#include <core/AssetArchive.h>
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "用法: " << argv[0] << " <输入目录> <输出文件> [--prefix 路径前缀] [--align 字节数] [--compress]" << std::endl;
+        return 1;
+    }
+
+    fs::path inputDir = argv[1];
+    std::string outputPath = argv[2];
+    std::string prefix;
+    std::uint32_t alignment = 64;
+    bool compress = false;
+    for (int i = 3; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--prefix" && i + 1 < argc) {
+            prefix = argv[++i];
+            if (!prefix.empty() && prefix.back() != '/') {
+                prefix += '/';
+            }
+        } else if (option == "--align" && i + 1 < argc) {
+            alignment = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        } else if (option == "--compress") {
+            compress = true;
+        } else {
+            std::cerr << "未知参数: " << option << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<fs::path> files;
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(inputDir, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_regular_file()) {
+            files.push_back(it->path());
+        }
+    }
+    if (error) {
+        std::cerr << "无法遍历输入目录: " << inputDir << " " << error.message() << std::endl;
+        return 1;
+    }
+    // 固定顺序保证相同输入得到相同的资源包
+    std::sort(files.begin(), files.end());
+
+    try {
+        GE::AssetArchiveWriter writer(alignment);
+        for (const fs::path& file : files) {
+            writer.AddFile(prefix + fs::relative(file, inputDir).generic_string(), file.string(), compress);
+        }
+        if (!writer.Write(outputPath)) {
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "已打包 " << files.size() << " 个文件到 " << outputPath << std::endl;
+    return 0;
+}